@@ -0,0 +1,86 @@
+#ifndef ARTIFACTS_H
+#define ARTIFACTS_H
+
+#include <stdint.h>
+#include "passes.h"
+
+/// The build cache keeps the automata compiled for a spec in a directory
+/// (see --build-cache) so that recompiling a spec only rebuilds what its
+/// changes affect:
+///
+///   * the NFA of every non-terminal, keyed by the non-terminal's
+///     fingerprint (see fingerprint_non_terminals), which covers the
+///     non-terminals it refers to
+///   * the minimal DFA of every mode, keyed by the fingerprints of the
+///     mode's rules and the passes run over the NFAs
+///   * the rules of every imported module, keyed by the module's content
+///     and the passes run over the rules, which lets a spec link the
+///     module without parsing it or building its NFAs (see
+///     set_module_cache)
+///
+/// Every artifact is a file named after its kind and key, starting with
+/// an ArtifactHeader. Its body is written and read by the module owning
+/// the automaton, see build_nfa and build_cached_dfa. Artifacts are
+/// never updated, a changed rule gets a new key, hence, several specs
+/// can share a cache. Stale artifacts are left for the user to delete.
+
+#define ARTIFACT_MAGIC   0x52414641 /* "AFAR" */
+// bump whenever the layout of an artifact or the automata the compiler
+// builds for a rule change
+#define ARTIFACT_VERSION 1
+#define MAX_ARTIFACT_PATH_LEN 4096
+
+typedef enum {
+  NFA_ARTIFACT,
+  DFA_ARTIFACT,
+  MODULE_ARTIFACT
+} ArtifactKind;
+
+typedef struct ArtifactHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t kind;
+  uint32_t reserved;
+  uint64_t key;
+} ArtifactHeader, *ArtifactHeaderPtr;
+
+typedef struct ArtifactWriter {
+  FILE *out;
+  char path[MAX_ARTIFACT_PATH_LEN];
+  char tmpPath[MAX_ARTIFACT_PATH_LEN + 32];
+} ArtifactWriter, *ArtifactWriterPtr;
+
+/// Opens the artifact of the given kind and key for reading its body.
+/// Returns NULL if the cache doesn't have it or it's invalid, e.g. left
+/// by another version of the compiler.
+FILE *open_artifact(const char *dir, ArtifactKind kind, uint64_t key);
+
+/// Starts writing an artifact to a temporary file and writes its header.
+/// Returns FALSE if the file can't be created, failing to fill the cache
+/// only costs a rebuild next time.
+bool begin_artifact(ArtifactWriterPtr writer, const char *dir,
+                    ArtifactKind kind, uint64_t key);
+
+/// Closes the artifact and renames it into place if ok is TRUE and every
+/// write succeeded, otherwise deletes it. A concurrent compiler never
+/// sees a partial artifact.
+void end_artifact(ArtifactWriterPtr writer, bool ok);
+
+/// Writes a NUL terminated string, NULL included, as its length followed
+/// by its bytes
+void write_artifact_string(FILE *out, const char *string);
+
+/// Reads a string write_artifact_string wrote into a buffer of maxSize
+/// bytes. Returns FALSE if it's malformed or doesn't fit. A NULL string
+/// sets *isNull, it's only valid if isNull != NULL.
+bool read_artifact_string(FILE *in, char *buf, int maxSize, bool *isNull);
+
+/// Returns a hash of the passes the pipeline runs
+uint64_t pipeline_fingerprint(PipelinePtr pipeline);
+
+/// Returns the key of the DFA of the given mode
+uint64_t mode_fingerprint(int mode, NonTerminalPtr nontermTable,
+                          int nontermTableSize, uint64_t *fingerprints,
+                          PipelinePtr pipeline);
+
+#endif
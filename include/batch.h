@@ -0,0 +1,75 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "scanner.h"
+#include "search.h"
+
+#define DEFAULT_CHUNK_SIZE (8L << 20)
+
+typedef enum {
+  TEXT_TOKENS,
+  // see tokfile.h
+  BINARY_TOKENS
+} TokenFormat;
+
+typedef struct BatchOptions {
+  int numThreads;
+  // directory to write the token files to. If NULL, a file's tokens are
+  // written next to it
+  const char *outDir;
+  // files larger than this are split into chunks scanned in parallel
+  long chunkSize;
+  // read the files with io_uring (see read_files_uring) if available
+  bool useUring;
+  // if not NULL, the token files of scanned inputs are also stored in
+  // this directory, keyed by the spec and the input's content hash. An
+  // input whose entry is found there is not scanned again.
+  const char *cacheDir;
+  TokenFormat format;
+  // only count the tokens of every kind (see count_buffer), no token
+  // files are written
+  bool countOnly;
+  // if not NULL, the occurrences of the searcher's non-terminal are
+  // written (or counted) instead of the tokens of the whole input
+  SearcherPtr searcher;
+  // append the positions of the spec's tags to the token lines. Only
+  // supported by the text format when tokenizing.
+  bool captureTags;
+  // append the decoded values of literals to the token lines, see
+  // DecoderType. Has the same restrictions as captureTags.
+  bool decodeValues;
+  // the symbol table of the intern decoder, shared by all workers
+  SymbolTablePtr symbols;
+} BatchOptions, *BatchOptionsPtr;
+
+typedef struct BatchStats {
+  long numFiles;
+  long numFailed;
+  long numBytes;
+  long numTokens;
+  long numUnmatched;
+  long numCacheHits;
+  // only filled in count mode, indexed like the counts of count_buffer
+  long kindCounts[MAX_NONTERMS + 1];
+  double seconds;
+} BatchStats, *BatchStatsPtr;
+
+void init_batch_options(BatchOptionsPtr options);
+
+/// Scans every file in paths and writes its tokens to <path>.tokens (see
+/// write_tokens_text) or, in the binary format, to <path>.tokb. Files
+/// are distributed over a pool of options->numThreads workers, each with
+/// its own deque of tasks. A worker that runs out of tasks steals from
+/// the others. Large files are split into chunks at separator bytes (see
+/// Scanner) and the chunks are pushed as separate tasks so that idle
+/// workers can steal them.
+///
+/// Returns the number of files that couldn't be read or written.
+int lex_batch(ScannerPtr scanner, char **paths, int numPaths,
+              BatchOptionsPtr options, BatchStatsPtr stats);
+
+/// Reads a file containing one path per line. Returns a heap allocated
+/// array of paths and stores its size in numPaths.
+char **read_path_list(const char *listPath, int *numPaths);
+
+#endif
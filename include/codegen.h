@@ -0,0 +1,29 @@
+#ifndef CODEGEN_H
+#define CODEGEN_H
+
+#include "scanner.h"
+
+/// Writes a C scanner equivalent to the given one: same DFA, longest
+/// match rule, and white space skipping between tokens. The DFA's
+/// columns are merged into byte classes to keep the tables small.
+///
+/// The generated file defines
+///
+///   static long scan_tokens(const char *buf, long size, void *ctx);
+///
+/// which returns the number of unmatched bytes and runs the action of a
+/// non-terminal (see NonTerminal) inline, at the point where it's
+/// matched, instead of returning tokens for the caller to dispatch on.
+/// An action sees the matched bytes as lexeme and length, their position
+/// in buf as offset, and ctx as passed to scan_tokens. The file is meant
+/// to be #included by the C file that defines what the actions use.
+///
+/// Every mode of the spec gets a MODE_ constant. The scanner starts in
+/// MODE_INITIAL, switches modes after the tokens of rules with a
+/// [begin:NAME] annotation, and an action can switch modes itself with
+/// BEGIN(MODE_NAME), which takes precedence over the rule's annotation.
+/// Trailing contexts are resolved like scan_buffer does, the tables of
+/// their tags are only emitted for specs that have any.
+void emit_c_scanner(FILE *out, ScannerPtr scanner);
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef DECODE_H
+#define DECODE_H
+
+#include <stdint.h>
+#include "utils.h"
+
+/// Decoders turn the lexeme of a literal into its value. They're applied
+/// by the scanner right after matching a token whose rule has a decoder
+/// (see DecoderType), while the lexeme is still in the cache.
+
+/// Accumulates the decimal digits of buf, other bytes (e.g. digit
+/// separators) are skipped. Overflows wrap around.
+uint64_t decode_decimal(const char *buf, long size);
+
+/// Like decode_decimal but for hex digits. A leading 0x only contributes
+/// a leading zero, hence, it needs no special handling.
+uint64_t decode_hex(const char *buf, long size);
+
+/// Returns the character between the first and the last bytes of buf
+/// (the quotes), decoding a \ escape
+int decode_char(const char *buf, long size);
+
+/// Decodes the characters between the first and the last bytes of buf
+/// (the quotes) into out, which must have room for size bytes, and NUL
+/// terminates it. Returns the decoded length.
+long decode_string(const char *buf, long size, char *out);
+
+#endif
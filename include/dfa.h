@@ -0,0 +1,75 @@
+#ifndef DFA_H
+#define DFA_H
+
+#include <stdint.h>
+#include "nfa.h"
+
+#define ALPHABET_SIZE   256
+// like the NFA pools, the states and tag ops pools grow on demand, up to
+// room for the DFA of a big dictionary
+#define INITIAL_DFA_STATES   4096
+#define MAX_DFA_STATES       (1 << 18)
+#define MAX_DFAS             64
+#define DEAD_STATE           -1
+#define NO_TOKEN             -1
+#define NO_TAG_OPS           -1
+#define INITIAL_TAG_OPS_ROWS (INITIAL_DFA_STATES / 4)
+#define MAX_TAG_OPS_ROWS     (1 << 15)
+
+/// The tags (see Tag) set by every transition of a DFA state. Bit t of
+/// row[c] is set if the transition on byte c crosses tag t, i.e. the tag's
+/// position is right after c.
+typedef uint32_t TagOpsRow[ALPHABET_SIZE];
+
+typedef struct DFAState {
+  // indexed by the input byte, DEAD_STATE if there is no transition
+  PoolOffset transitions[ALPHABET_SIZE];
+  // index of the non-terminal accepted in this state or NO_TOKEN. When
+  // several non-terminals accept, the one that appeared first in the spec
+  // wins
+  int token;
+  // the decoder of a literal of the accepted token ending in this state,
+  // see DecoderType. If the matches of several decoded non-terminals end
+  // here, the one whose NFA state comes first is used.
+  DecoderType decoder;
+  // index of the state's row in the tag ops table or NO_TAG_OPS if none
+  // of its transitions crosses a tag, which is the case for most states
+  PoolOffset tagOps;
+} DFAState, *DFAStatePtr;
+
+typedef struct DFA {
+  PoolOffset start;
+  // states of a DFA occupy a contiguous range of the states pool
+  // starting at its start state
+  int numStates;
+  // the tags crossed before reading anything, their position is 0
+  uint32_t startTags;
+} DFA, *DFAPtr;
+
+/// Converts the NFA at nfaIdx to a DFA using the subset construction.
+/// For more details check "Engineering a Compiler", 2011, Section 2.4.3
+///
+/// The accepting states of the NFA are expected to be ordered by the
+/// non-terminal they accept, i.e. nfa->accepting[i] accepts non-terminal
+/// i (see build_nfa).
+///
+/// Returns the index of the new DFA in dfaTable. If dfaStateTable !=
+/// NULL, it's filled with pointers to the pools storing the DFA states
+/// and the DFAs. The states pool moves when it grows, hence, the pointer
+/// is only valid until the next DFA is built, as is get_tag_ops_table's.
+PoolOffset build_dfa(NFAStatePtr nfaStateTable, NFAEdgePtr nfaEdgeTable,
+                     NFAPtr nfaTable, PoolOffset nfaIdx,
+                     DFAStatePtr *dfaStateTable, DFAPtr *dfaTable);
+
+/// Like build_dfa, but reuses the minimal DFA stored in the build cache in
+/// cacheDir (see artifacts.h) under the given key if there's one, and
+/// stores the DFA it builds there otherwise
+PoolOffset build_cached_dfa(NFAStatePtr nfaStateTable, NFAEdgePtr nfaEdgeTable,
+                            NFAPtr nfaTable, PoolOffset nfaIdx,
+                            DFAStatePtr *dfaStateTable, DFAPtr *dfaTable,
+                            const char *cacheDir, uint64_t key);
+
+/// Returns the table DFAState::tagOps indexes into
+TagOpsRow *get_tag_ops_table();
+
+#endif
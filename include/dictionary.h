@@ -0,0 +1,64 @@
+#ifndef DICTIONARY_H
+#define DICTIONARY_H
+
+#include "utils.h"
+
+// the pools are allocated by the first dictionary and grow on demand, up
+// to room for dictionaries of about a million words, whose minimal
+// automata usually have a fraction of a state per word
+#define INITIAL_DICT_STATES (1 << 12)
+#define INITIAL_DICT_EDGES  (1 << 13)
+#define MAX_DICT_STATES     (1 << 20)
+#define MAX_DICT_EDGES      (1 << 21)
+#define MAX_DICTS           64
+#define MAX_WORD_LEN        256
+
+typedef struct DictEdge {
+  unsigned char symbol;
+  PoolOffset target;
+} DictEdge, *DictEdgePtr;
+
+/// A state of the minimal acyclic DFA of a dictionary. Its edges occupy
+/// a contiguous range of the edges pool, in increasing order of symbols.
+typedef struct DictState {
+  PoolOffset firstEdge;
+  int numEdges;
+  // a word ends in this state
+  bool final;
+} DictState, *DictStatePtr;
+
+/// A dictionary's states occupy a contiguous range of the states pool
+/// ending at its root, the last state built
+typedef struct Dictionary {
+  PoolOffset first;
+  PoolOffset root;
+  long numWords;
+} Dictionary, *DictionaryPtr;
+
+typedef enum {
+  DICTIONARY_OK,
+  WORDS_OUT_OF_ORDER,
+  WORD_TOO_LONG
+} DictionaryStatus;
+
+/// Reads a file of words, one per line, sorted in byte order (e.g. by
+/// LC_ALL=C sort) and builds its minimal acyclic DFA. The DFA is built
+/// incrementally as the words are read (Daciuk et al.'s algorithm for
+/// sorted input): once a word is added, the states only the previous word
+/// went through can't change anymore, and each of them is replaced by an
+/// equivalent state built earlier, if there is one. Hence, the time and
+/// memory needed are linear in the size of the input and the minimal DFA
+/// respectively, the trie of the words is never built.
+///
+/// Empty lines and repeated words are ignored. On success, dictIdx is set
+/// to the index of the new dictionary, otherwise line is set to the line
+/// of the offending word.
+DictionaryStatus load_dictionary(FILE *in, PoolOffset *dictIdx, long *line);
+
+/// Fills the given pointers with the pools storing the dictionaries. The
+/// pools move when they grow, hence, the pointers are only valid until
+/// the next dictionary is loaded.
+void get_dictionary_tables(DictStatePtr *states, DictEdgePtr *edges,
+                           DictionaryPtr *dicts);
+
+#endif
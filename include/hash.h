@@ -0,0 +1,11 @@
+#ifndef HASH_H
+#define HASH_H
+
+#include <stdint.h>
+#include "utils.h"
+
+/// xxHash64 of the given bytes. Fast, but not cryptographic: it's meant
+/// for recognizing identical inputs, not for resisting crafted ones.
+uint64_t hash_bytes(const void *data, size_t size, uint64_t seed);
+
+#endif
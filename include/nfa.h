@@ -1,4 +1,130 @@
+#ifndef NFA_H
+#define NFA_H
+
 #include "regex.h"
 
-void build_nfa(NonTerminalPtr nontermTable, int nontermTableSize,
-               ExpressionPtr exprTable, char *termTable);
+// Thompson's Construction gives every state at most 2 outgoing edges,
+// the only exceptions being the start state of the combined NFA which has
+// an edge per non-terminal, and the states built for the & and ~
+// operators (see product.h) which have an edge per range of bytes with
+// the same target. The latter rarely have more than a few, hence, the
+// edges pool is sized for an average of 4 edges per state.
+//
+// The pools start with room for an ordinary spec and double when they
+// fill up, up to the MAX_ sizes, which have room for the DFA of a
+// dictionary (see load_dictionary) of a million natural language words,
+// or of 100K random ones, which share far fewer suffixes.
+#define INITIAL_NFA_STATES 16384
+#define INITIAL_NFA_EDGES  (4 * INITIAL_NFA_STATES + MAX_NONTERMS)
+#define INITIAL_NFAS       (INITIAL_NFA_STATES / 4)
+#define MAX_NFA_STATES     (1 << 18)
+#define MAX_NFA_EDGES      (4 * MAX_NFA_STATES + MAX_NONTERMS)
+#define MAX_NFAS           (1 << 16)
+#define MAX_EDGES_PER_NODE 128
+#define EPSILON            0
+#define NO_STATE           -1
+#define DEBUG              1
+
+typedef enum {
+  START,
+  INTERNAL,
+  ACCEPTING
+} NFAStateType;
+
+typedef struct NFAState {
+  PoolOffset edges[MAX_EDGES_PER_NODE];
+  int numEdges;
+  NFAStateType type;
+  // the decoder of the non-terminal whose match ends in this state, if
+  // it has one. Set for every copy of the non-terminal, including the
+  // ones embedded in other non-terminals' NFAs.
+  DecoderType decoder;
+  // the non-terminal whose top-level NFA (see get_non_terminal_nfa) the
+  // state belongs to
+  int owner;
+#if DEBUG
+  bool visited;
+#endif
+} NFAState, *NFAStatePtr;
+
+typedef struct NFAEdge {
+  PoolOffset target;
+  // the edge matches the bytes from symbol to last, inclusive. Only the
+  // edges built for the & and ~ operators have last != symbol.
+  char symbol;
+  char last;
+  // an epsilon edge built for a TAG operand carries the tag's index,
+  // every other edge carries NO_TAG
+  int tag;
+} NFAEdge, *NFAEdgePtr;
+
+typedef struct NFA {
+  PoolOffset start;
+  PoolOffset accepting[MAX_EDGES_PER_NODE];
+  int numAccepting;
+} NFA, *NFAPtr;
+
+/// Builds one NFA per non-terminal and combines the ones of every mode
+/// (see Mode) into a single NFA whose start state has an epsilon edge to
+/// the start of each of them. Returns the index of the initial mode's
+/// combined NFA in nfaTable, see get_mode_nfa for the others. A combined
+/// NFA's accepting[i] is the accepting state of the i-th non-terminal's
+/// NFA or NO_STATE if the non-terminal belongs to another mode.
+///
+/// If nfaStateTable != NULL, it's filled with pointers to the pools
+/// storing the states, edges, and NFAs, see get_nfa_tables.
+PoolOffset build_nfa(NonTerminalPtr nontermTable, int nontermTableSize,
+                     ExpressionPtr exprTable, char *termTable,
+                     NFAStatePtr *nfaStateTable, NFAEdgePtr *nfaEdgeTable,
+                     NFAPtr *nfaTable);
+
+/// Makes build_nfa look for the NFA of every non-terminal in the build
+/// cache in dir (see artifacts.h) before building it, keyed by the
+/// non-terminal's fingerprint, and store the ones it builds there. A NULL
+/// dir, the default, turns the cache off.
+void set_nfa_cache(const char *dir, uint64_t *fingerprints);
+
+/// Fills the given pointers with the pools storing the states, edges, and
+/// NFAs. The pools move when they grow, e.g. in build_reverse_nfa, hence,
+/// the pointers are only valid until the next NFA is built.
+void get_nfa_tables(NFAStatePtr *states, NFAEdgePtr *edges, NFAPtr *nfas);
+
+/// Returns the number of states in the pool, every NFA built so far has
+/// its states below it
+int get_num_nfa_states();
+
+/// Returns the index of the combined NFA of the given mode
+PoolOffset get_mode_nfa(int mode);
+
+/// Returns the index of the NFA build_nfa built for the non-terminal
+/// itself. It has a single accepting state, hence, build_dfa turns it
+/// into a DFA whose accepting states accept token 0.
+PoolOffset get_non_terminal_nfa(int nontermIdx);
+
+/// Builds an NFA matching any bytes followed by a string the NFA at
+/// nfaIdx matches, reversed. Run backwards over an input, its DFA hence
+/// accepts right after reading the first byte of every match, see
+/// search_buffer. The tags and decoders of the NFA are dropped. Returns
+/// -1 without building anything if more than maxStates states are
+/// reachable in the NFA, which keeps the DFA from growing too big.
+PoolOffset build_reverse_nfa(PoolOffset nfaIdx, int maxStates);
+
+/// Drops the rules that can't match anything, e.g. an & of disjoint
+/// non-terminals, from the combined NFAs, i.e. the edge from the start
+/// state to their NFA. Returns the number of rules dropped.
+int remove_dead_rules();
+
+/// Redirects every edge leading to a state whose only edge is an epsilon
+/// one, e.g. the accepting state of the first operand of a concatenation,
+/// to where that edge leads, which shrinks the epsilon closures build_dfa
+/// computes. The states where tokens end and the ones carrying a decoder
+/// or a tagged edge are kept. Returns the number of edges redirected.
+int bypass_epsilon_states();
+
+/// Returns the number of states reachable from the start states of the
+/// combined NFAs and sets numEdges to the number of their edges
+int count_nfa_states(int *numEdges);
+
+void print_nfa_graphviz(PoolOffset nfaIdx);
+
+#endif
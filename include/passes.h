@@ -0,0 +1,52 @@
+#ifndef PASSES_H
+#define PASSES_H
+
+#include "nfa.h"
+
+#define MAX_PIPELINE_PASSES 32
+
+typedef enum {
+  // rewrites the rules' expressions, run between parse_regex_spec and
+  // build_nfa
+  AST_PASS,
+  // rewrites the combined NFAs, run between build_nfa and build_dfa
+  NFA_PASS
+} PassKind;
+
+/// An optimization of the spec's compilation. A pass must not change the
+/// tokens the scanner produces, only how big the compiled spec gets or
+/// how fast the later phases go.
+typedef struct Pass {
+  const char *name;
+  PassKind kind;
+  const char *description;
+  // returns the number of rewrites the pass made
+  int (*run)();
+} Pass, *PassPtr;
+
+/// The passes to run, as indices into the registered passes, in the order
+/// they run in. The AST passes all run before the NFA ones regardless.
+typedef struct Pipeline {
+  int passes[MAX_PIPELINE_PASSES];
+  int numPasses;
+  // print the time every pass took and the size of the expressions or
+  // NFAs before and after it to stderr
+  bool printStats;
+} Pipeline, *PipelinePtr;
+
+/// Fills the pipeline with every registered pass, in the order they're
+/// registered in
+void init_default_pipeline(PipelinePtr pipeline);
+
+/// Replaces the pipeline's passes with the comma separated list of names,
+/// e.g. plus-closures,dead-rules, or none for no pass at all. Returns
+/// FALSE, leaving the pipeline unchanged, if a name isn't registered.
+bool parse_pipeline(PipelinePtr pipeline, char *list);
+
+/// Runs the pipeline's passes of the given kind
+void run_passes(PipelinePtr pipeline, PassKind kind);
+
+/// Prints the registered passes, one per line
+void print_passes(FILE *out);
+
+#endif
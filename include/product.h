@@ -0,0 +1,49 @@
+#ifndef PRODUCT_H
+#define PRODUCT_H
+
+#include "dfa.h"
+
+#define MAX_PRODUCT_STATES 4096
+#define MAX_PRODUCT_DFAS   64
+
+/// A state of the small DFAs build_nfa uses to compile the & and ~
+/// operators, which Thompson's Construction can't express. Unlike
+/// DFAState, a state only knows whether it accepts.
+typedef struct ProductState {
+  // indexed by the input byte, DEAD_STATE if there is no transition
+  PoolOffset transitions[ALPHABET_SIZE];
+  bool accepting;
+} ProductState, *ProductStatePtr;
+
+typedef struct ProductDFA {
+  PoolOffset start;
+  // states of a DFA occupy a contiguous range of the states pool
+  // starting at its start state
+  int numStates;
+} ProductDFA, *ProductDFAPtr;
+
+/// Converts the part of an NFA between start and accepting to a DFA
+/// using the subset construction. Tags are ignored, they don't survive
+/// a product. Returns the index of the new DFA.
+PoolOffset determinize_nfa(NFAStatePtr nfaStateTable, NFAEdgePtr nfaEdgeTable,
+                           PoolOffset start, PoolOffset accepting);
+
+/// Builds the product of 2 DFAs, accepting the strings both accept. Only
+/// the pairs of states reachable from the start pair are built, and pairs
+/// from which no accepting pair is reachable are dropped.
+PoolOffset intersect_dfas(PoolOffset dfa1Idx, PoolOffset dfa2Idx);
+
+/// Builds a DFA accepting the strings the given one rejects. The DFA is
+/// completed with an accepting sink state first. Byte 0 is never part of
+/// a string, it marks epsilon edges (see EPSILON).
+PoolOffset complement_dfa(PoolOffset dfaIdx);
+
+/// Fills the given pointers with the pools storing the DFAs' states and
+/// the DFAs. The pools are emptied by free_product_dfas.
+void get_product_tables(ProductStatePtr *states, ProductDFAPtr *dfas);
+
+/// Empties the pools, the DFAs are only needed until they are turned back
+/// into NFAs
+void free_product_dfas();
+
+#endif
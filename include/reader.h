@@ -0,0 +1,34 @@
+#ifndef READER_H
+#define READER_H
+
+#include "utils.h"
+
+typedef struct InputFile {
+  const char *path;
+  // heap allocated, 1 byte larger than size. NULL if reading failed
+  char *buf;
+  long size;
+} InputFile, *InputFilePtr;
+
+/// Called for each file as soon as its content is available (or reading
+/// it failed, in which case file->buf is NULL). May block to keep the
+/// reader from getting too far ahead of whoever consumes the files.
+typedef void (*InputReadyCallback)(InputFilePtr file, void *arg);
+
+/// Reads the files using io_uring. Opens, size queries, reads, and closes
+/// of up to queueDepth / 4 files are submitted at once so that a whole
+/// window of files costs a couple of system calls instead of 4 per file.
+/// A file whose io_uring requests fail is read with read_file_pread
+/// before it's handed to ready.
+///
+/// Returns FALSE without reading anything if io_uring isn't available
+/// (not Linux, built without <linux/io_uring.h>, or rejected by the
+/// kernel).
+bool read_files_uring(InputFilePtr *files, int numFiles, int queueDepth,
+                      InputReadyCallback ready, void *arg);
+
+/// Reads a whole file using open, fstat, and pread. Returns FALSE and
+/// reports the error if it can't.
+bool read_file_pread(const char *path, char **buf, long *size);
+
+#endif
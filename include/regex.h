@@ -2,29 +2,88 @@
 #define REGEX_H
 
 #include "utils.h"
+#include "unicode.h"
 
 #define MAX_NONTERMS       256
 #define MAX_TOTAL_TERM_LEN 8192
 #define MAX_NONTERM_NAME   64
-// an average of 4 nested expressions per non-terminal looks like a reasonable
-// value, this is multiplied by the maximum # of non-terms we can have
-#define MAX_NESTED_EXPRS   4 * MAX_NONTERMS
+// the parser itself needs about 4 nested expressions per non-terminal,
+// factor_literal_alternations rebuilds an alternation of literals as a
+// chain of an OR and an AND (see factor_literals) per group of literals
+// sharing a prefix, hence, 16 per non-terminal
+#define MAX_NESTED_EXPRS   (16 * MAX_NONTERMS)
 #define MAX_REGEX_LEN      1024
+#define MAX_TOTAL_ACTION_LEN 16384
+// tags are tracked as bits of a 32-bit mask, see dfa.h
+#define MAX_TAGS           32
+#define NO_TAG             -1
+#define MAX_MODES          16
+#define MAX_CODE_POINT_SETS    256
+#define MAX_CODE_POINT_RANGES  16384
+#define INITIAL_MODE       0
+#define NO_MODE            -1
+// the expr of a non-terminal linked from a module's artifact, see
+// set_module_cache. Its NFA comes from the build cache instead.
+#define LINKED_EXPR        -1
+#define MAX_MODULES        64
+#define MAX_MODULE_PATH    256
+// the files a spec reads besides itself, see get_spec_files
+#define MAX_SPEC_FILES     128
 
 typedef enum {
    NO_OP,
    OR,
    AND,
-   ZERO_OR_MORE
+   ZERO_OR_MORE,
+   // x+, never written in a spec, the plus-closures pass rewrites x x*
+   // into it so that x's NFA is only built once
+   ONE_OR_MORE,
+   // written & between 2 operands, matches what both of them match
+   INTERSECT
 } OperatorType;
 
 typedef enum {
   NESTED_EXPRESSION,
   NON_TERMINAL,
+  // the operand is the offset of the terminal in the terminals pool, the
+  // same string always being stored at the same offset
   TERMINAL,
+  // a terminal matching its letters in either case, written @^literal or
+  // any terminal of a non-terminal annotated with [nocase]
+  CASELESS_TERMINAL,
+  // the complement of a non-terminal, written ~$name, matching every
+  // string the non-terminal doesn't match. The operand is the
+  // non-terminal's index, like for NON_TERMINAL.
+  COMPLEMENT,
+  // a set of code points matching their UTF-8 encodings, written
+  // @u{41-5a,e9} with hexadecimal code points or ranges of them, or
+  // @p{L,Nd} with Unicode general categories. The operand is an index
+  // into the code point sets, see CodePointSet.
+  CODE_POINTS,
+  // the words of a dictionary file, written @w{path} with a path relative
+  // to the working directory. The operand is the dictionary's index, see
+  // load_dictionary.
+  DICTIONARY,
+  // a position marker (written @#name) matching the empty string. The
+  // scanner can report where in a token the match passed it.
+  TAG,
   NOTHING
 } OperandType;
 
+/// How the value of a literal is decoded from its lexeme, see decode.h.
+/// Written as an annotation in the header of a non-terminal's line, e.g.
+///
+///   $decimal_literal [decimal] := $digit $digit*
+typedef enum {
+  NO_DECODER,
+  DECIMAL_DECODER,
+  HEX_DECODER,
+  CHAR_DECODER,
+  STRING_DECODER,
+  // the value is the id of the lexeme in a symbol table, see symbols.h
+  INTERN_DECODER
+} DecoderType;
+
 typedef struct Expression {
   // each operand can be either a terminal (char[]), a non-terminal
   // (an instance of NonTerminal struct), or even a nested expression
@@ -44,15 +103,59 @@ typedef struct Expression {
 // are simple char[]) in places where is suitable.
 typedef struct NonTerminal {
   char name[MAX_NONTERM_NAME];
-  // the expression defining the non-terminal
+  // the expression defining the non-terminal, or LINKED_EXPR
   PoolOffset expr;
   // this will be false when a non-terminal is used in the definition of another one
   // before its definition is actually parsed
   _Bool complete;
   // index into the global nonterms array. Only for debugging purposes for now.
   int idx;
+  DecoderType decoder;
+  // written [skip] in the header. The scanner drops the non-terminal's
+  // tokens, e.g. comments, instead of emitting them.
+  _Bool skip;
+  // written [nocase] in the header. The letters of the non-terminal's
+  // own terminals match in either case, the non-terminals it refers to
+  // aren't affected.
+  _Bool nocase;
+  // the start condition (see Mode) the non-terminal's rule is active in,
+  // written <NAME> in the header, INITIAL_MODE by default
+  int mode;
+  // the mode the scanner switches to after matching the non-terminal,
+  // written [begin:NAME] in the header, NO_MODE to stay in the same mode
+  int nextMode;
+  // the tag marking where the trailing context of the rule starts, i.e.
+  // the @/ in r @/ s, or NO_TAG. The non-terminal matches r only if it's
+  // followed by s, see Tag.
+  int trailTag;
+  // the C code written between @{ and @} at the end of the non-terminal's
+  // line or NULL. Generated scanners run it whenever they match the
+  // non-terminal, see codegen.h.
+  char *action;
 } NonTerminal, *NonTerminalPtr;
 
+typedef struct Tag {
+  char name[MAX_NONTERM_NAME];
+  // TRUE for the hidden tag of a trailing context (see NonTerminal),
+  // named @/ followed by the non-terminal's name. Such tags aren't
+  // reported, the scanner ends the token at them instead.
+  _Bool trailing;
+} Tag, *TagPtr;
+
+/// The sorted and disjoint ranges of a CODE_POINTS operand, stored back
+/// to back with the ranges of the other sets
+typedef struct CodePointSet {
+  PoolOffset first;
+  int numRanges;
+} CodePointSet, *CodePointSetPtr;
+
+/// A start condition, i.e. a set of rules the scanner matches while it's
+/// in this mode, like flex's exclusive start conditions. Every mode gets
+/// its own DFA. Mode INITIAL_MODE, named INITIAL, always exists.
+typedef struct Mode {
+  char name[MAX_NONTERM_NAME];
+} Mode, *ModePtr;
+
 /*
 /// A binary search tree for non-terminals
 /// To keep things simple, no balancing is implemented at this phase
@@ -72,4 +175,74 @@ struct NonTerminalNode* right;
 int parse_regex_spec(FILE* in, NonTerminalPtr* nontermTable,
                      ExpressionPtr *exprTable, char **termTale);
 
+/// Makes parse_regex_spec link the modules a spec imports from their
+/// artifacts in the given build cache instead of parsing them, see
+/// artifacts.h. A module is a spec file imported with a line like
+///
+///   @import lang/numbers.spec
+///
+/// with a path relative to the working directory, whose rules become
+/// visible to the rest of the importing file. A module only sees its own
+/// rules and the ones it imports itself, and its imports come before its
+/// rules. A linked module's rules keep their names, annotations, and
+/// actions, but not their expressions: their NFAs are loaded from the
+/// cache as they are. Hence, a module is only linked if the tags its
+/// rules use get the same indices as when it was compiled and neither
+/// its imports nor its dictionaries changed, otherwise it's parsed.
+/// The artifacts are also keyed by passesKey, which must change whenever
+/// the passes rewriting the rules do, see pipeline_fingerprint.
+void set_module_cache(const char *dir, uint64_t passesKey);
+
+/// Fills paths with the files parse_regex_spec read so far besides the
+/// spec itself, i.e. the modules the spec imports and the dictionaries
+/// of its @w{path} operands, and returns their number. The compilation
+/// depends on their content, see --watch.
+int get_spec_files(const char **paths);
+
+/// Stores the artifacts of the modules parse_regex_spec parsed rather
+/// than linked. fingerprints are the ones fingerprint_non_terminals
+/// filled, every rule's NFA must be in the cache by the time the module
+/// is linked.
+void save_module_artifacts(uint64_t *fingerprints);
+
+/// Rewrites every alternation of 2 or more literals, e.g. $rel_op's
+/// < | > | <= | >=, into the trie of its literals, i.e. < (= | ) | > (= | ),
+/// so that literals sharing a prefix share its NFA states instead of each
+/// getting its own chain. A literal that's a prefix of another becomes an
+/// empty terminal. Only the literals of the same kind (TERMINAL or
+/// CASELESS_TERMINAL) at the head of an alternation are factored, the
+/// operands from the first other one on are kept as they are. Returns the
+/// number of alternations rewritten.
+int factor_literal_alternations();
+
+/// Rewrites every x x* whose x is a single operand, e.g. the $digit $digit*
+/// of decimal literals, into x+, which builds x's NFA once instead of
+/// twice. Returns the number of expressions rewritten.
+int fold_plus_closures();
+
+/// Returns the number of distinct expressions the rules refer to, i.e.
+/// the size of the rules' DAG, ignoring the expressions rewrites left
+/// behind
+int count_rule_exprs();
+
+/// Fills fingerprints[i] with a hash of everything the NFA of the i-th
+/// non-terminal is built from: its decoder and expressions, the strings,
+/// tags, code points, and dictionaries they match, and the fingerprints
+/// of the non-terminals they refer to. Non-terminals with the same
+/// fingerprint get the same NFA, see artifacts.h.
+void fingerprint_non_terminals(uint64_t *fingerprints);
+
+/// Returns the number of distinct tags used by the parsed spec. If
+/// tagTable != NULL, it's filled with a pointer to the tags, a TAG
+/// operand being an index into it.
+int get_tags(TagPtr *tagTable);
+
+/// Returns the number of modes of the parsed spec, see get_tags
+int get_modes(ModePtr *modeTable);
+
+/// Returns the number of code point sets of the parsed spec. If sets !=
+/// NULL, it's filled with a pointer to the sets and ranges with a pointer
+/// to the ranges they index into.
+int get_code_point_sets(CodePointSetPtr *sets, CodePointRangePtr *ranges);
+
 #endif
@@ -0,0 +1,166 @@
+#ifndef SCANNER_H
+#define SCANNER_H
+
+#include <stdint.h>
+#include "dfa.h"
+#include "symbols.h"
+
+typedef struct Token {
+  long offset;
+  int length;
+  // index of the matched non-terminal or NO_TOKEN for a byte no rule
+  // matches
+  int kind;
+} Token, *TokenPtr;
+
+/// The decoded value of a token, see DecoderType
+typedef struct TokenValue {
+  // NO_DECODER if the token has no value
+  DecoderType decoder;
+  // the integer, character, or symbol id, or for strings, the offset of
+  // the decoded NUL terminated string in TokenBuffer::strings
+  long value;
+} TokenValue, *TokenValuePtr;
+
+/// A growable array of tokens. Unlike the compiler's data, the number
+/// of tokens depends on the scanned input, hence, it's heap allocated.
+typedef struct TokenBuffer {
+  TokenPtr tokens;
+  long size;
+  long capacity;
+  // if numTags > 0, the positions of the tags captured for tokens[i] are
+  // stored at tags[i*numTags], relative to the token's offset, -1 for a
+  // tag not crossed by the token
+  int *tags;
+  int numTags;
+  // if decodeValues is TRUE, values[i] is the decoded value of tokens[i]
+  TokenValuePtr values;
+  bool decodeValues;
+  char *strings;
+  long stringsSize;
+  long stringsCapacity;
+  // where the intern decoder adds its symbols, can be shared by the
+  // buffers of several threads
+  SymbolTablePtr symbols;
+} TokenBuffer, *TokenBufferPtr;
+
+typedef enum {
+  // white space between tokens, or a single byte token of a skipped
+  // non-terminal
+  DISPATCH_SKIP,
+  // no token starts with the byte
+  DISPATCH_UNMATCHED,
+  // the byte is a whole token on its own: the state it leads to accepts
+  // and has no transitions out of it
+  DISPATCH_SINGLE_BYTE,
+  // a longer token might start with the byte, continue from state
+  DISPATCH_ENTER
+} DispatchType;
+
+/// What to do with the first byte of a token, see Scanner
+typedef struct DispatchEntry {
+  DispatchType type;
+  // the state after the byte and the token it accepts (or NO_TOKEN)
+  PoolOffset state;
+  int token;
+  // the tags crossed by the transition, see TagOpsRow
+  uint32_t tagOps;
+} DispatchEntry, *DispatchEntryPtr;
+
+/// The DFA of a mode (see Mode) as used by the scanner
+typedef struct ScannerMode {
+  PoolOffset start;
+  uint32_t startTags;
+  // indexed by the first byte of a token. Resolves skipping white space,
+  // the start state's transition, and single byte tokens (e.g. most
+  // operators and punctuation) with a single lookup, without entering
+  // the DFA loop.
+  DispatchEntry dispatch[ALPHABET_SIZE];
+} ScannerMode, *ScannerModePtr;
+
+/// Everything needed to scan an input with a DFA per mode. The scanner
+/// only reads the DFA tables, hence, a single Scanner can be shared by
+/// many threads.
+typedef struct Scanner {
+  DFAStatePtr states;
+  // the states of all modes' DFAs, which are contiguous starting at the
+  // initial mode's start state
+  PoolOffset start;
+  int numStates;
+  ScannerMode modes[MAX_MODES];
+  int numModes;
+  ModePtr modeTable;
+  NonTerminalPtr nontermTable;
+  int nontermTableSize;
+  // separators[c] is TRUE if no state has a transition on c, i.e. no
+  // token can contain c. Scanning always restarts right after such a
+  // byte, which makes it a safe place to split an input. Only meaningful
+  // for specs with a single mode, the mode at a split isn't known.
+  bool separators[ALPHABET_SIZE];
+  // skipped[k] is TRUE if the tokens of non-terminal k are dropped, see
+  // NonTerminal
+  bool skipped[MAX_NONTERMS];
+  // nextMode[k] is the mode to switch to after a token of non-terminal k
+  // or NO_MODE
+  int nextMode[MAX_NONTERMS];
+  // trailTag[k] is the tag ending the tokens of non-terminal k if its
+  // rule has a trailing context, NO_TAG otherwise
+  int trailTag[MAX_NONTERMS];
+  bool hasTrailingContext;
+  TagPtr tagTable;
+  int numTags;
+  TagOpsRow *tagOps;
+  // identifies the DFA and the token names, i.e. everything the tokens
+  // produced for an input depend on besides the input itself
+  uint64_t specHash;
+} Scanner, *ScannerPtr;
+
+/// dfas are the DFAs of the numModes modes, in order. Their states are
+/// expected to be contiguous, which is the case for DFAs built one after
+/// the other.
+void init_scanner(ScannerPtr scanner, DFAStatePtr dfaStateTable, DFAPtr dfas,
+                  int numModes, NonTerminalPtr nontermTable,
+                  int nontermTableSize);
+
+/// Splits buf into tokens using the longest match rule and appends them
+/// to tokens. Scanning starts in the initial mode, where white space
+/// between tokens is skipped. The tokens of skipped non-terminals are
+/// dropped without leaving the scanning loop. Token offsets are relative
+/// to baseOffset which allows scanning an input in pieces.
+///
+/// If tokens->numTags > 0 (see init_tagged_token_buffer), the position of
+/// every tag is captured along with the tokens in the same pass. If
+/// tokens->decodeValues is TRUE, the values of the literals whose rules
+/// have a decoder are decoded as well.
+///
+/// A token of a rule with a trailing context (r @/ s) is matched like any
+/// other, then cut at the position of its trailing tag, in the same pass.
+/// The bytes matched by s are scanned again as the start of the next
+/// token.
+///
+/// Returns the number of bytes that didn't match any rule.
+long scan_buffer(ScannerPtr scanner, const char *buf, long size,
+                 long baseOffset, TokenBufferPtr tokens);
+
+/// Like scan_buffer but only counts the tokens of every kind instead of
+/// storing them. counts must have room for nontermTableSize + 1 entries:
+/// counts[0] counts the bytes that didn't match any rule and counts[k+1]
+/// the tokens of non-terminal k. The counts are added to, not reset.
+///
+/// Returns the number of bytes that didn't match any rule.
+long count_buffer(ScannerPtr scanner, const char *buf, long size,
+                  long *counts);
+
+/// Writes one "offset length name" line per token, followed by a
+/// "tag=position" pair per tag captured for the token and its decoded
+/// "value=..." if it has one
+void write_tokens_text(FILE *out, ScannerPtr scanner, TokenBufferPtr tokens);
+
+void append_token(TokenBufferPtr tokens, long offset, int length, int kind);
+void init_token_buffer(TokenBufferPtr tokens);
+/// Like init_token_buffer but for capturing the positions of numTags
+/// tags, the number of tags of the scanner
+void init_tagged_token_buffer(TokenBufferPtr tokens, int numTags);
+void free_token_buffer(TokenBufferPtr tokens);
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include "scanner.h"
+
+#define MAX_PREFILTER_LEN 64
+// rules with more NFA states than this are searched without a reverse DFA
+// (see Searcher), which could need more states than the pool has, e.g.
+// for a big dictionary
+#define MAX_REVERSE_NFA_STATES (MAX_DFA_STATES / 16)
+
+/// Finds the occurrences of a single non-terminal anywhere in an input,
+/// without tokenizing the rest of it.
+typedef struct Searcher {
+  DFAStatePtr states;
+  // start of the DFA built for the searched non-terminal alone
+  PoolOffset start;
+  // start of the DFA that, run backwards, accepts where a match starts
+  // (see build_reverse_nfa), or -1 if the non-terminal is too big for one
+  PoolOffset reverseStart;
+  int nontermIdx;
+  // the tag ending the matches if the non-terminal's rule has a trailing
+  // context, NO_TAG otherwise, and the table of the DFA's tags
+  int trailTag;
+  TagOpsRow *tagOps;
+  // every match starts with prefix, which is empty if the expression
+  // has no such literal
+  char prefix[MAX_PREFILTER_LEN];
+  int prefixLen;
+  // the bytes a match can start with
+  bool firstBytes[ALPHABET_SIZE];
+  // identifies the spec and the searched non-terminal, see Scanner
+  uint64_t specHash;
+} Searcher, *SearcherPtr;
+
+/// Builds the DFA of the non-terminal and extracts the prefilter from its
+/// expression. build_nfa must have been called before. The new DFAs may
+/// move the pools the scanner points into, its pointers are updated.
+void init_searcher(SearcherPtr searcher, ScannerPtr scanner, int nontermIdx,
+                   ExpressionPtr exprTable, char *termTable,
+                   NFAStatePtr nfaStateTable, NFAEdgePtr nfaEdgeTable,
+                   NFAPtr nfaTable);
+
+/// Appends the leftmost longest, non-overlapping, non-empty matches in
+/// buf to matches as tokens of the searched non-terminal. Candidate
+/// positions are found with memmem (or memchr) for the required prefix,
+/// or by skipping the bytes no match starts with. From the first one on,
+/// a single backward pass of the reverse DFA finds where matches start,
+/// and only those positions are run through the DFA, which keeps a
+/// candidate that doesn't match from costing a scan of the rest of buf.
+/// Like in scan_buffer, a match of a rule with a trailing context (r @/ s)
+/// ends where s starts.
+///
+/// Returns the number of matches found.
+long search_buffer(SearcherPtr searcher, const char *buf, long size,
+                   long baseOffset, TokenBufferPtr matches);
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef SYMBOLS_H
+#define SYMBOLS_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include "utils.h"
+
+#define DEFAULT_SYMBOL_CAPACITY (1 << 16)
+#define NO_SYMBOL               -1
+// symbols are stored in chunks that never move, hence, up to
+// SYMBOL_CHUNK_SIZE * MAX_SYMBOL_CHUNKS symbols
+#define SYMBOL_CHUNK_SIZE       (1 << 16)
+#define MAX_SYMBOL_CHUNKS       (1 << 14)
+#define NAME_CHUNK_SIZE         (1 << 20)
+
+typedef struct Symbol {
+  uint64_t hash;
+  // names aren't NUL terminated
+  const char *name;
+  int nameLength;
+} Symbol, *SymbolPtr;
+
+/// The slots of a SymbolTable, see there
+typedef struct SymbolSlots {
+  // symbol id + 1, 0 for an empty slot, BUSY_SLOT, or MOVED_SLOT
+  _Atomic int *slots;
+  long numSlots;
+  // the slots replaced by these ones, freed with the table
+  struct SymbolSlots *prev;
+} SymbolSlots, *SymbolSlotsPtr;
+
+/// An open addressing (linear probing) hash table from names to dense
+/// symbol ids, shared by all scanning threads without locks on lookups.
+/// A slot is claimed with a CAS from empty to busy, the symbol is then
+/// filled in and its id published with a release store. A thread probing
+/// a busy slot waits for the id, which only takes a few instructions.
+///
+/// The slots are kept at most half full. Once they aren't, the thread
+/// that filled them moves the ids to twice as many slots: every empty
+/// slot of the old ones is marked moved, which makes the threads probing
+/// them retry on the new ones as soon as they're published. The old slots
+/// stay valid for the threads still reading them until the table is
+/// freed. The symbols and their names live in chunks that never move, so
+/// only adding a symbol takes a lock.
+typedef struct SymbolTable {
+  _Atomic(SymbolSlotsPtr) slots;
+  pthread_mutex_t growLock;
+  // guards the symbols and names being added
+  pthread_mutex_t addLock;
+  _Atomic(SymbolPtr) symbolChunks[MAX_SYMBOL_CHUNKS];
+  atomic_int numSymbols;
+  char **nameChunks;
+  int numNameChunks;
+  int nameChunksCapacity;
+  // room left in the last name chunk
+  char *nameEnd;
+  long nameRoom;
+} SymbolTable, *SymbolTablePtr;
+
+/// Sets up a table with room for capacity symbols before it first grows
+void init_symbol_table(SymbolTablePtr table, int capacity);
+void free_symbol_table(SymbolTablePtr table);
+
+/// Returns the id of the symbol named by the given bytes, adding it if
+/// it's new. Ids are handed out in the order symbols are added, starting
+/// at 0. Safe to call from several threads at once.
+int intern_symbol(SymbolTablePtr table, const char *name, int length);
+
+/// Writes one "id name" line per symbol
+void write_symbols(FILE *out, SymbolTablePtr table);
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef TOKFILE_H
+#define TOKFILE_H
+
+#include "scanner.h"
+
+/// A binary token file stores the same information as the text format
+/// (see write_tokens_text) in a fraction of its size:
+///
+///   header | block 0 | block 1 | ... | block index
+///
+/// Each block holds up to TOKEN_FILE_BLOCK_SIZE tokens, every token being
+/// 3 LEB128 varints: kind + 1 (0 for unmatched bytes), the gap between
+/// the end of the previous token and the token's offset, and its length.
+/// The block index stores, for every block, where it starts in the file
+/// and the end of the token preceding it. This way any block can be
+/// decoded on its own, without decoding the ones before it.
+
+#define TOKEN_FILE_MAGIC      0x4b544641 /* "AFTK" */
+#define TOKEN_FILE_VERSION    1
+#define TOKEN_FILE_BLOCK_SIZE 1024
+// 3 varints of at most 10 bytes each
+#define MAX_ENCODED_TOKEN_LEN 30
+
+typedef struct TokenFileHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t specHash;
+  uint64_t numTokens;
+  uint64_t numBlocks;
+  uint64_t indexOffset;
+} TokenFileHeader, *TokenFileHeaderPtr;
+
+typedef struct TokenBlockEntry {
+  uint64_t fileOffset;
+  // end offset (in the scanned input) of the token preceding the block
+  uint64_t prevEnd;
+} TokenBlockEntry, *TokenBlockEntryPtr;
+
+typedef struct TokenFileWriter {
+  FILE *out;
+  TokenFileHeader header;
+  unsigned char block[TOKEN_FILE_BLOCK_SIZE * MAX_ENCODED_TOKEN_LEN];
+  int blockLen;
+  int blockTokens;
+  long prevEnd;
+  TokenBlockEntryPtr index;
+  uint64_t indexCapacity;
+} TokenFileWriter, *TokenFileWriterPtr;
+
+/// A token file mapped into memory. Nothing is decoded until asked for.
+typedef struct TokenFile {
+  const unsigned char *data;
+  size_t size;
+  const TokenFileHeader *header;
+  const TokenBlockEntry *index;
+} TokenFile, *TokenFilePtr;
+
+void open_token_writer(TokenFileWriterPtr writer, FILE *out,
+                       uint64_t specHash);
+/// Appends tokens, which must follow the ones appended before
+void write_tokens_binary(TokenFileWriterPtr writer, TokenBufferPtr tokens);
+/// Flushes the last block, writes the block index, and fills in the
+/// header. Doesn't close the underlying FILE.
+void close_token_writer(TokenFileWriterPtr writer);
+
+/// Maps a token file into memory. Returns FALSE and reports the error if
+/// it can't be read or isn't a token file, including a header or block
+/// index pointing outside of the file.
+bool open_token_file(const char *path, TokenFilePtr file);
+void close_token_file(TokenFilePtr file);
+
+/// Decodes block blockIdx into tokens, which must have room for
+/// TOKEN_FILE_BLOCK_SIZE tokens. Returns the number of tokens decoded, or
+/// -1 if the block is corrupt. The kinds aren't checked against the spec.
+int read_token_block(TokenFilePtr file, uint64_t blockIdx, TokenPtr tokens);
+
+/// Decodes the token at tokenIdx by decoding only the block holding it.
+/// Returns FALSE if the block is corrupt.
+bool read_token(TokenFilePtr file, uint64_t tokenIdx, TokenPtr token);
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef UNICODE_H
+#define UNICODE_H
+
+#include <stdint.h>
+#include "utils.h"
+
+#define MAX_CODE_POINT 0x10FFFF
+#define MAX_UTF8_LEN   4
+// a range covering every encoded length is split into 1 + 3 + 5 + 7
+// sequences at worst, see split_utf8_sequences
+#define MAX_SEQUENCES_PER_RANGE 16
+// returned instead of a number of ranges when they don't fit in the
+// space given
+#define TOO_MANY_RANGES -2
+
+typedef struct CodePointRange {
+  uint32_t first;
+  uint32_t last;
+} CodePointRange, *CodePointRangePtr;
+
+/// A range of code points of the same general category, e.g. "Lu" for
+/// upper case letters. See categories.c.
+typedef struct CategoryRange {
+  uint32_t first;
+  uint32_t last;
+  char category[3];
+} CategoryRange, *CategoryRangePtr;
+
+/// The UTF-8 encodings of a range of code points whose encodings have the
+/// same length, and differ in a suffix of whole bytes only. An encoding
+/// matches the sequence if its byte i is in [first[i], last[i]].
+typedef struct Utf8Sequence {
+  int length;
+  unsigned char first[MAX_UTF8_LEN];
+  unsigned char last[MAX_UTF8_LEN];
+} Utf8Sequence, *Utf8SequencePtr;
+
+/// The assigned code points, sorted, except for the surrogates and the
+/// private use ones
+extern const CategoryRange categoryTable[];
+extern const int categoryTableSize;
+
+/// Appends the ranges of the code points of a general category to
+/// ranges. A single letter name, e.g. L, stands for all the categories
+/// starting with it. Returns the number of appended ranges, -1 if the
+/// category doesn't exist, or TOO_MANY_RANGES if it has more than
+/// maxRanges.
+int get_category_ranges(const char *name, int nameSize,
+                        CodePointRangePtr ranges, int maxRanges);
+
+/// Sorts the ranges and merges the overlapping and adjacent ones in
+/// place. Surrogates, which have no UTF-8 encoding, and code point 0 are
+/// cut out, which may split a range in 2. Returns the new number of
+/// ranges, or TOO_MANY_RANGES if they need more than maxRanges.
+int normalize_code_point_ranges(CodePointRangePtr ranges, int numRanges,
+                                int maxRanges);
+
+/// Splits a range of code points into the UTF-8 sequences matching
+/// exactly the encodings of its code points, in increasing order, see
+/// "Regular Expression Matching in the Wild", Russ Cox, 2010. sequences
+/// must have room for MAX_SEQUENCES_PER_RANGE entries. Returns the
+/// number of sequences.
+int split_utf8_sequences(CodePointRange range, Utf8SequencePtr sequences);
+
+#endif
@@ -10,10 +10,56 @@
 #define log(msg, ...)                    \
   fprintf(stdout, (msg), ## __VA_ARGS__)
 
+// for pools an input can fill, e.g. with a big dictionary, where an
+// assert would let a release build write past the pool
+#define pool_overflow(what, size)                                   \
+  fprintf(stderr, "Error: the spec needs more than %ld %s\n",       \
+          (long)(size), (what));                                    \
+  exit(1)
+
 #define TRUE  1
 #define FALSE 0
 
 typedef int PoolOffset;
 typedef int bool;
 
+/// Returns the capacity a pool allocated on demand needs to hold needed
+/// elements: its current one, or initial if it has none yet, doubled
+/// until it's enough, up to max. A spec needing more than max elements
+/// is reported with pool_overflow.
+static inline int grow_capacity(int capacity, long needed, int initial,
+                                int max, const char *what) {
+  if (needed > max) {
+    pool_overflow(what, max);
+  }
+
+  long newCapacity = capacity > 0 ? capacity : initial;
+
+  while (newCapacity < needed) {
+    newCapacity *= 2;
+  }
+
+  return newCapacity < max ? newCapacity : max;
+}
+
+/// Reallocates a pool of oldCapacity elements of the given size, or
+/// allocates it if it's NULL, to hold newCapacity of them. Like in a
+/// static pool, the new elements are zeroed.
+static inline void *resize_pool(void *pool, int oldCapacity, int newCapacity,
+                                size_t size) {
+  if (pool == NULL) {
+    pool = calloc(newCapacity, size);
+  } else {
+    pool = realloc(pool, (size_t)newCapacity*size);
+
+    if (pool != NULL) {
+      memset((char *)pool + (size_t)oldCapacity*size, 0,
+             (size_t)(newCapacity - oldCapacity)*size);
+    }
+  }
+
+  assert(pool != NULL && "Out of memory!\n");
+  return pool;
+}
+
 #endif
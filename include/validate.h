@@ -0,0 +1,41 @@
+#ifndef VALIDATE_H
+#define VALIDATE_H
+
+#include <stdint.h>
+#include "dfa.h"
+
+// number of strings validate_strings steps through the DFA at once
+#define VALIDATE_INTERLEAVE 4
+
+/// Checks whether whole strings match a single non-terminal. The DFA of
+/// the non-terminal is copied into a compact table of its own in which
+/// state 0 is a real dead state that loops to itself, which frees the
+/// inner loop from checking for dead states.
+typedef struct Validator {
+  // table[s * ALPHABET_SIZE + c]
+  PoolOffset *table;
+  bool *accepting;
+  int numStates;
+  PoolOffset start;
+} Validator, *ValidatorPtr;
+
+/// Builds the DFA of the non-terminal. build_nfa must have been called
+/// before.
+void init_validator(ValidatorPtr validator, int nontermIdx,
+                    NFAStatePtr nfaStateTable, NFAEdgePtr nfaEdgeTable,
+                    NFAPtr nfaTable);
+void free_validator(ValidatorPtr validator);
+
+/// Sets bit i of matches (bit i % 64 of word i / 64) iff strs[i], of
+/// length lens[i], matches the non-terminal as a whole. matches must have
+/// room for (numStrs + 63) / 64 words.
+///
+/// VALIDATE_INTERLEAVE strings are run through the DFA side by side. Each
+/// transition depends on the previous one, interleaving independent
+/// strings lets the CPU overlap their table loads.
+void validate_strings(ValidatorPtr validator, const char *const *strs,
+                      const int *lens, long numStrs, uint64_t *matches);
+
+bool validate_string(ValidatorPtr validator, const char *str, int len);
+
+#endif
@@ -6,8 +6,57 @@
 ! @|   marks a literal |
 ! @*   marks a literal *
 ! @$   marks a literal $
+! @t   marks a literal tab
+! @n   marks a literal new line
 ! |    separates 2 alternatives
 ! *    >= 0 instances
+! &    between 2 operands, matches what both of them match, e.g.
+!      $id & ~$keyword. A & glued to other characters (e.g. &&) is a
+!      literal, @& always is
+! ~$x  matches every string $x doesn't match. @~ marks a literal ~
+! @#   marks the start of a tag, a named position inside a token that
+!      the scanner can report, e.g. where the digits of a hex literal
+!      start
+! @u{41-5a,e9}
+!      matches one code point of the given hex ranges, encoded in UTF-8
+! @p{L,Nd}
+!      matches one code point of the given Unicode general categories
+!      (a letter like L stands for all its categories)
+! @w{path}
+!      matches one of the words of a file, one word per line sorted by
+!      bytes (LC_ALL=C sort), e.g. a list of reserved names far too long
+!      to spell out as alternatives. The path is relative to the working
+!      directory
+! @^   before a literal, matches its letters in either case, e.g. @^select
+! @/   marks the start of a trailing context: r @/ s matches r only if
+!      it's followed by s, the token ends before s
+! [d]  after a non-terminal's name, decodes the value of its literals
+!      with decoder d: decimal, hex, char, or string. The intern decoder
+!      gives every distinct lexeme a symbol id instead, see
+!      symbols.spec
+! [nocase]
+!      after a non-terminal's name, matches the letters of all its
+!      literals in either case
+! [skip]
+!      after a non-terminal's name, drops its tokens, e.g. comments.
+!      White space between tokens is always dropped
+! <NAME>
+!      after a non-terminal's name, makes its rule active only in the
+!      start condition (mode) NAME instead of INITIAL. Every mode only
+!      matches its own rules and white space is only dropped in INITIAL
+! [begin:NAME]
+!      after a non-terminal's name, switches to mode NAME after matching
+!      the non-terminal
+! @{ code @}
+!      at the end of a line, C code that scanners generated with --emit-c
+!      run whenever they match the non-terminal
+! @import path
+!      on a line of its own, makes the non-terminals of another spec file
+!      (a module) visible to the rest of this one. The path is relative to
+!      the working directory. A module only sees its own non-terminals and
+!      the ones it imports itself, and its imports come before its rules.
+!      With --build-cache, an unchanged module is linked from the cache
+!      instead of being parsed again
 !
 ! Using a special escape character like @ reduces the chance of
 ! instroducing errors. For example, an expression like a | | c
@@ -48,12 +97,16 @@ $hex_digit := $digit | a | b | c | d | e | f | A | B | C | D | E | F
 
 $int_literal := $decimal_literal | $hex_literal
 
-$decimal_literal := $digit $digit*
+$decimal_literal [decimal] := $digit $digit*
 
-$hex_literal := 0x $hex_digit $hex_digit*
+$hex_literal [hex] := 0x @#hex_digits $hex_digit $hex_digit*
 
-$char_literal := ' $char '
+$char_literal [char] := ' @#char $char '
 
-$string_literal := " $char* "
+$string_literal [string] := " $char* "
 
 $char := @@ | ! | # | @$ | % | & | ( | ) | @* | + | , | - | . | / | 0 | 1 | 2 | 3 | 4 | 5 | 6 | 7 | 8 | 9 | : | ; | < | = | > | ? | @@ | A | B | C | D | E | F | G | H | I | J | K | L | M | N | O | P | Q | R | S | T | U | V | W | X | Y | Z | [ | ] | ^ | _ | ` | a | b | c | d | e | f | g | h | i | j | k | l | m | n | o | p | q | r | s | t | u | v | w | x | y | z | { | @| | } | ~ | \" | \' | \\
+
+! the printable characters, space, and tab. A rule for them would be a
+! token of its own, matching a stray " or \ outside of comments
+$comment [skip] := // @u{9,20-7e}*
@@ -0,0 +1,17 @@
+! Identifiers interned into a symbol table while scanning: with --values,
+! every $name token gets the id of its lexeme, the same for every
+! occurrence, and --symbols writes the table. The ids depend on the order
+! the scanning threads meet the names in, hence, they can't be combined
+! with --cache. See decaf.spec for the conventions.
+
+$name [intern] := $letter $letter_or_digit*
+
+$number [decimal] := $digit $digit*
+
+$punct := = | ; | ( | ) | ,
+
+$letter_or_digit := $letter | $digit
+
+$letter := A | B | C | D | E | F | G | H | I | J | K | L | M | N | O | P | Q | R | S | T | U | V | W | X | Y | Z | a | b | c | d | e | f | g | h | i | j | k | l | m | n | o | p | q | r | s | t | u | v | w | x | y | z | _
+
+$digit := 0 | 1 | 2 | 3 | 4 | 5 | 6 | 7 | 8 | 9
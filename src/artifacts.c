@@ -0,0 +1,114 @@
+#include <unistd.h>
+#include "../include/artifacts.h"
+#include "../include/hash.h"
+
+static void artifact_path(char *path, const char *dir, ArtifactKind kind,
+                          uint64_t key);
+
+FILE *open_artifact(const char *dir, ArtifactKind kind, uint64_t key) {
+  char path[MAX_ARTIFACT_PATH_LEN];
+  ArtifactHeader header;
+  artifact_path(path, dir, kind, key);
+  FILE *in = fopen(path, "rb");
+
+  if (in == NULL) {
+    return NULL;
+  }
+
+  if (fread(&header, sizeof(ArtifactHeader), 1, in) != 1
+      || header.magic != ARTIFACT_MAGIC || header.version != ARTIFACT_VERSION
+      || header.kind != (uint32_t)kind || header.key != key) {
+    fclose(in);
+    return NULL;
+  }
+
+  return in;
+}
+
+bool begin_artifact(ArtifactWriterPtr writer, const char *dir,
+                    ArtifactKind kind, uint64_t key) {
+  ArtifactHeader header = { ARTIFACT_MAGIC, ARTIFACT_VERSION, kind, 0, key };
+  artifact_path(writer->path, dir, kind, key);
+  snprintf(writer->tmpPath, sizeof(writer->tmpPath), "%s.tmp%ld",
+           writer->path, (long)getpid());
+  writer->out = fopen(writer->tmpPath, "wb");
+
+  if (writer->out == NULL) {
+    return FALSE;
+  }
+
+  fwrite(&header, sizeof(ArtifactHeader), 1, writer->out);
+  return TRUE;
+}
+
+void end_artifact(ArtifactWriterPtr writer, bool ok) {
+  ok = !ferror(writer->out) && ok;
+
+  if (fclose(writer->out) != 0 || !ok
+      || rename(writer->tmpPath, writer->path) != 0) {
+    unlink(writer->tmpPath);
+  }
+}
+
+void write_artifact_string(FILE *out, const char *string) {
+  int size = string == NULL ? -1 : (int)strlen(string);
+  fwrite(&size, sizeof(int), 1, out);
+
+  if (size > 0) {
+    fwrite(string, 1, size, out);
+  }
+}
+
+bool read_artifact_string(FILE *in, char *buf, int maxSize, bool *isNull) {
+  int size;
+
+  if (fread(&size, sizeof(int), 1, in) != 1 || size < -1 || size >= maxSize
+      || (size == -1 && isNull == NULL)) {
+    return FALSE;
+  }
+
+  if (isNull != NULL) {
+    *isNull = size == -1;
+  }
+
+  if (size == -1) {
+    return TRUE;
+  }
+
+  buf[size] = '\0';
+  return fread(buf, 1, size, in) == (size_t)size;
+}
+
+uint64_t pipeline_fingerprint(PipelinePtr pipeline) {
+  return hash_bytes(pipeline->passes, pipeline->numPasses*sizeof(int),
+                    ARTIFACT_VERSION);
+}
+
+uint64_t mode_fingerprint(int mode, NonTerminalPtr nontermTable,
+                          int nontermTableSize, uint64_t *fingerprints,
+                          PipelinePtr pipeline) {
+  uint64_t hash = hash_bytes(&nontermTableSize, sizeof(int), ARTIFACT_VERSION);
+  hash = hash_bytes(pipeline->passes, pipeline->numPasses*sizeof(int), hash);
+
+  // a rule's token is its index, which the key must cover too
+  for (int i=0 ; i<nontermTableSize ; i++) {
+    if (nontermTable[i].mode == mode) {
+      hash = hash_bytes(&i, sizeof(int), hash);
+      hash = hash_bytes(fingerprints + i, sizeof(uint64_t), hash);
+    }
+  }
+
+  return hash;
+}
+
+static void artifact_path(char *path, const char *dir, ArtifactKind kind,
+                          uint64_t key) {
+  static const char *extensions[] = {
+    [NFA_ARTIFACT] = "nfa",
+    [DFA_ARTIFACT] = "dfa",
+    [MODULE_ARTIFACT] = "mod"
+  };
+
+  snprintf(path, MAX_ARTIFACT_PATH_LEN, "%s/%016llx.%s", dir,
+           (unsigned long long)key, extensions[kind]);
+}
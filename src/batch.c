@@ -0,0 +1,663 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "../include/batch.h"
+#include "../include/reader.h"
+#include "../include/hash.h"
+#include "../include/tokfile.h"
+
+#define INITIAL_DEQUE_CAPACITY 256
+#define MAX_PATH_LEN           4096
+#define URING_QUEUE_DEPTH      256
+#define COPY_BUFFER_SIZE       (64 << 10)
+// how far the reader may get ahead of the workers, see on_file_read
+#define MAX_UNSCANNED_FILES    (URING_QUEUE_DEPTH / 4)
+#define MAX_UNSCANNED_BYTES    (256L << 20)
+
+typedef enum {
+  FILE_TASK,
+  CHUNK_TASK
+} TaskType;
+
+/// A file being scanned. Small files are scanned as a whole by the worker
+/// that takes the file's task. Large ones are split into chunks; the
+/// worker that finishes the last chunk writes the tokens of all of them.
+///
+/// The input is the first member so that the InputFilePtrs handed back by
+/// the reader can be treated as FileJobPtrs.
+typedef struct FileJob {
+  InputFile input;
+  // TRUE if the reader already read the file (input.buf is NULL if that
+  // failed), otherwise the worker reads it itself
+  bool loaded;
+  // hash of the file's content, only computed when caching is enabled
+  uint64_t contentHash;
+  int numChunks;
+  // chunk i spans [chunkStarts[i], chunkStarts[i+1])
+  long *chunkStarts;
+  TokenBuffer *chunkTokens;
+  atomic_int remainingChunks;
+} FileJob, *FileJobPtr;
+
+typedef struct Task {
+  TaskType type;
+  FileJobPtr file;
+  int chunk;
+} Task, *TaskPtr;
+
+/// The owner pushes and pops tasks at the bottom of its deque while
+/// thieves take them from the top, i.e. the oldest tasks which, for
+/// split files, are the chunks the owner would get to last.
+typedef struct WorkerDeque {
+  pthread_mutex_t lock;
+  TaskPtr tasks;
+  int top;
+  int bottom;
+  int capacity;
+} WorkerDeque, *WorkerDequePtr;
+
+typedef struct Worker {
+  pthread_t thread;
+  int idx;
+  WorkerDeque deque;
+  BatchStats stats;
+} Worker, *WorkerPtr;
+
+static ScannerPtr scanner;
+static BatchOptionsPtr options;
+static FileJobPtr fileJobs;
+static Worker *workers;
+static int numWorkers;
+// tasks pushed but not finished yet, the workers exit when it hits 0
+static atomic_long pendingTasks;
+// files the reader handed over that weren't released yet, and the size
+// of their buffers
+static atomic_long unscannedFiles;
+static atomic_long unscannedBytes;
+
+static void *worker_main(void *arg);
+static bool run_next_task(WorkerPtr worker);
+static bool take_task(WorkerPtr worker, TaskPtr task);
+static void push_task(WorkerDequePtr deque, Task task);
+static bool pop_bottom(WorkerDequePtr deque, TaskPtr task);
+static bool pop_top(WorkerDequePtr deque, TaskPtr task);
+static void run_file_task(WorkerPtr worker, FileJobPtr file);
+static void run_chunk_task(WorkerPtr worker, FileJobPtr file, int chunk);
+static void scan_piece(WorkerPtr worker, const char *buf, long size,
+                       long baseOffset, TokenBufferPtr tokens);
+static void init_piece_tokens(TokenBufferPtr tokens);
+static void split_file(FileJobPtr file);
+static uint64_t output_spec_hash();
+static void on_file_read(InputFilePtr input, void *arg);
+static bool write_file_tokens(FileJobPtr file, TokenBuffer *chunkTokens,
+                              int numChunks);
+static const char *output_extension();
+static void output_path(FileJobPtr file, char *outPath);
+static void cache_path(FileJobPtr file, char *cachePath);
+static bool copy_file(const char *fromPath, const char *toPath);
+static void release_file(FileJobPtr file);
+static double now_seconds();
+
+void init_batch_options(BatchOptionsPtr batchOptions) {
+  long numCores = sysconf(_SC_NPROCESSORS_ONLN);
+  batchOptions->numThreads = numCores > 0 ? (int)numCores : 1;
+  batchOptions->outDir = NULL;
+  batchOptions->chunkSize = DEFAULT_CHUNK_SIZE;
+  batchOptions->useUring = TRUE;
+  batchOptions->cacheDir = NULL;
+  batchOptions->format = TEXT_TOKENS;
+  batchOptions->countOnly = FALSE;
+  batchOptions->searcher = NULL;
+  batchOptions->captureTags = FALSE;
+  batchOptions->decodeValues = FALSE;
+  batchOptions->symbols = NULL;
+}
+
+int lex_batch(ScannerPtr _scanner, char **paths, int numPaths,
+              BatchOptionsPtr _options, BatchStatsPtr stats) {
+  scanner = _scanner;
+  options = _options;
+  numWorkers = options->numThreads > 0 ? options->numThreads : 1;
+  double startTime = now_seconds();
+
+  fileJobs = calloc(numPaths, sizeof(FileJob));
+  workers = calloc(numWorkers, sizeof(Worker));
+  assert(fileJobs != NULL && workers != NULL && "Out of memory!\n");
+
+  for (int i=0 ; i<numWorkers ; i++) {
+    workers[i].idx = i;
+    pthread_mutex_init(&workers[i].deque.lock, NULL);
+  }
+
+  atomic_store(&pendingTasks, numPaths);
+  atomic_store(&unscannedFiles, 0);
+  atomic_store(&unscannedBytes, 0);
+
+  for (int i=1 ; i<numWorkers ; i++) {
+    pthread_create(&workers[i].thread, NULL, worker_main, workers + i);
+  }
+
+  // with io_uring, this thread reads the files and hands each one to a
+  // worker as soon as it's in memory. Otherwise, or if io_uring isn't
+  // available, the workers read the files themselves.
+  InputFilePtr *inputs = malloc(numPaths*sizeof(InputFilePtr));
+  int nextWorker = 0;
+  assert(inputs != NULL && "Out of memory!\n");
+
+  for (int i=0 ; i<numPaths ; i++) {
+    fileJobs[i].input.path = paths[i];
+    inputs[i] = &fileJobs[i].input;
+  }
+
+  if (!options->useUring
+      || !read_files_uring(inputs, numPaths, URING_QUEUE_DEPTH, on_file_read,
+                           &nextWorker)) {
+    // deal the files round robin, stealing evens out whatever imbalance
+    // this leaves
+    for (int i=0 ; i<numPaths ; i++) {
+      Task task = { FILE_TASK, fileJobs + i, 0 };
+      push_task(&workers[i % numWorkers].deque, task);
+    }
+  }
+
+  free(inputs);
+  worker_main(workers);
+  memset(stats, 0, sizeof(BatchStats));
+
+  for (int i=0 ; i<numWorkers ; i++) {
+    if (i > 0) {
+      pthread_join(workers[i].thread, NULL);
+    }
+
+    stats->numFiles += workers[i].stats.numFiles;
+    stats->numFailed += workers[i].stats.numFailed;
+    stats->numBytes += workers[i].stats.numBytes;
+    stats->numTokens += workers[i].stats.numTokens;
+    stats->numUnmatched += workers[i].stats.numUnmatched;
+    stats->numCacheHits += workers[i].stats.numCacheHits;
+
+    for (int k=0 ; k<=scanner->nontermTableSize ; k++) {
+      stats->kindCounts[k] += workers[i].stats.kindCounts[k];
+      stats->numTokens += workers[i].stats.kindCounts[k];
+    }
+
+    pthread_mutex_destroy(&workers[i].deque.lock);
+    free(workers[i].deque.tasks);
+  }
+
+  stats->seconds = now_seconds() - startTime;
+  free(workers);
+  free(fileJobs);
+  return (int)stats->numFailed;
+}
+
+char **read_path_list(const char *listPath, int *numPaths) {
+  FILE *list = fopen(listPath, "r");
+
+  if (list == NULL) {
+    fprintf(stderr, "Error: cannot open file list %s\n", listPath);
+    exit(1);
+  }
+
+  char line[MAX_PATH_LEN];
+  int capacity = 0;
+  char **paths = NULL;
+  *numPaths = 0;
+
+  while (fgets(line, MAX_PATH_LEN, list) != NULL) {
+    size_t len = strcspn(line, "\r\n");
+    line[len] = '\0';
+
+    if (len == 0) {
+      continue;
+    }
+
+    if (*numPaths == capacity) {
+      capacity = capacity == 0 ? 64 : 2 * capacity;
+      paths = realloc(paths, capacity*sizeof(char*));
+      assert(paths != NULL && "Out of memory!\n");
+    }
+
+    paths[(*numPaths)++] = strdup(line);
+  }
+
+  fclose(list);
+  return paths;
+}
+
+/// Called by the reader for every file it read, arg points to the index
+/// of the worker to get the next file.
+///
+/// Doesn't return while the files handed over but not released yet
+/// exceed MAX_UNSCANNED_FILES or MAX_UNSCANNED_BYTES, which keeps the
+/// reader from holding the whole input in memory when the workers are
+/// slower than it. The buffers it allocates meanwhile are bounded by its
+/// window. This thread is worker 0, it scans files itself while waiting.
+static void on_file_read(InputFilePtr input, void *arg) {
+  int *nextWorker = arg;
+  FileJobPtr file = (FileJobPtr)input;
+  file->loaded = TRUE;
+  atomic_fetch_add(&unscannedFiles, 1);
+  atomic_fetch_add(&unscannedBytes, input->buf != NULL ? input->size : 0);
+  Task task = { FILE_TASK, file, 0 };
+  push_task(&workers[(*nextWorker)++ % numWorkers].deque, task);
+
+  while (atomic_load(&unscannedFiles) > MAX_UNSCANNED_FILES
+         || (atomic_load(&unscannedBytes) > MAX_UNSCANNED_BYTES
+             && atomic_load(&unscannedFiles) > 1)) {
+    if (!run_next_task(workers)) {
+      sched_yield();
+    }
+  }
+}
+
+static void *worker_main(void *arg) {
+  WorkerPtr worker = arg;
+
+  while (atomic_load(&pendingTasks) > 0) {
+    if (!run_next_task(worker)) {
+      sched_yield();
+    }
+  }
+
+  return NULL;
+}
+
+/// Runs one of the tasks take_task finds, returns FALSE if there's none
+static bool run_next_task(WorkerPtr worker) {
+  Task task;
+
+  if (!take_task(worker, &task)) {
+    return FALSE;
+  }
+
+  if (task.type == FILE_TASK) {
+    run_file_task(worker, task.file);
+  } else {
+    run_chunk_task(worker, task.file, task.chunk);
+  }
+
+  atomic_fetch_sub(&pendingTasks, 1);
+  return TRUE;
+}
+
+/// Takes the newest task of the worker's own deque, or, if it's empty,
+/// steals the oldest task of another worker
+static bool take_task(WorkerPtr worker, TaskPtr task) {
+  if (pop_bottom(&worker->deque, task)) {
+    return TRUE;
+  }
+
+  for (int i=1 ; i<numWorkers ; i++) {
+    WorkerPtr victim = workers + (worker->idx + i) % numWorkers;
+
+    if (pop_top(&victim->deque, task)) {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+static void push_task(WorkerDequePtr deque, Task task) {
+  pthread_mutex_lock(&deque->lock);
+
+  if (deque->bottom == deque->capacity) {
+    // slide the live tasks back to the front before growing
+    int size = deque->bottom - deque->top;
+    memmove(deque->tasks, deque->tasks + deque->top, size*sizeof(Task));
+    deque->top = 0;
+    deque->bottom = size;
+
+    if (size == deque->capacity) {
+      deque->capacity = deque->capacity == 0 ? INITIAL_DEQUE_CAPACITY
+        : 2 * deque->capacity;
+      deque->tasks = realloc(deque->tasks, deque->capacity*sizeof(Task));
+      assert(deque->tasks != NULL && "Out of memory!\n");
+    }
+  }
+
+  deque->tasks[deque->bottom++] = task;
+  pthread_mutex_unlock(&deque->lock);
+}
+
+static bool pop_bottom(WorkerDequePtr deque, TaskPtr task) {
+  bool found = FALSE;
+  pthread_mutex_lock(&deque->lock);
+
+  if (deque->bottom > deque->top) {
+    *task = deque->tasks[--deque->bottom];
+    found = TRUE;
+  }
+
+  pthread_mutex_unlock(&deque->lock);
+  return found;
+}
+
+static bool pop_top(WorkerDequePtr deque, TaskPtr task) {
+  bool found = FALSE;
+
+  // don't wait for a busy victim, there are others to steal from
+  if (pthread_mutex_trylock(&deque->lock) != 0) {
+    return FALSE;
+  }
+
+  if (deque->bottom > deque->top) {
+    *task = deque->tasks[deque->top++];
+    found = TRUE;
+  }
+
+  pthread_mutex_unlock(&deque->lock);
+  return found;
+}
+
+static void run_file_task(WorkerPtr worker, FileJobPtr file) {
+  if (!file->loaded) {
+    read_file_pread(file->input.path, &file->input.buf, &file->input.size);
+  }
+
+  if (file->input.buf == NULL) {
+    worker->stats.numFailed++;
+    release_file(file);
+    return;
+  }
+
+  worker->stats.numFiles++;
+  worker->stats.numBytes += file->input.size;
+
+  if (options->cacheDir != NULL && !options->countOnly) {
+    char cachePath[MAX_PATH_LEN];
+    char outPath[MAX_PATH_LEN];
+    file->contentHash = hash_bytes(file->input.buf, file->input.size, 0);
+    cache_path(file, cachePath);
+    output_path(file, outPath);
+
+    // a missing entry fails to open, anything else is treated as a miss
+    // too and the entry gets rewritten below
+    if (copy_file(cachePath, outPath)) {
+      worker->stats.numCacheHits++;
+      release_file(file);
+      return;
+    }
+  }
+
+  if (file->input.size > options->chunkSize) {
+    split_file(file);
+
+    if (file->numChunks > 1) {
+      // account for the chunks before publishing them so that the pending
+      // count can't drop to 0 while they're still queued
+      atomic_fetch_add(&pendingTasks, file->numChunks);
+
+      for (int i=0 ; i<file->numChunks ; i++) {
+        Task task = { CHUNK_TASK, file, i };
+        push_task(&worker->deque, task);
+      }
+
+      return;
+    }
+  }
+
+  TokenBuffer tokens;
+  init_piece_tokens(&tokens);
+  scan_piece(worker, file->input.buf, file->input.size, 0, &tokens);
+
+  if (!options->countOnly && !write_file_tokens(file, &tokens, 1)) {
+    worker->stats.numFailed++;
+  }
+
+  free_token_buffer(&tokens);
+  release_file(file);
+}
+
+static void run_chunk_task(WorkerPtr worker, FileJobPtr file, int chunk) {
+  long chunkStart = file->chunkStarts[chunk];
+  long chunkSize = file->chunkStarts[chunk+1] - chunkStart;
+  TokenBufferPtr tokens = file->chunkTokens + chunk;
+  scan_piece(worker, file->input.buf + chunkStart, chunkSize, chunkStart,
+             tokens);
+
+  if (atomic_fetch_sub(&file->remainingChunks, 1) != 1) {
+    return;
+  }
+
+  if (!options->countOnly
+      && !write_file_tokens(file, file->chunkTokens, file->numChunks)) {
+    worker->stats.numFailed++;
+  }
+
+  for (int i=0 ; i<file->numChunks ; i++) {
+    free_token_buffer(file->chunkTokens + i);
+  }
+
+  release_file(file);
+}
+
+/// Scans, or searches, a whole file or one of its chunks. In count mode
+/// only the worker's counts are updated and tokens stays empty.
+static void scan_piece(WorkerPtr worker, const char *buf, long size,
+                       long baseOffset, TokenBufferPtr tokens) {
+  if (options->searcher != NULL) {
+    long numMatches = search_buffer(options->searcher, buf, size, baseOffset,
+                                    tokens);
+
+    if (options->countOnly) {
+      worker->stats.kindCounts[options->searcher->nontermIdx+1] += numMatches;
+      tokens->size = 0;
+    } else {
+      worker->stats.numTokens += numMatches;
+    }
+  } else if (options->countOnly) {
+    worker->stats.numUnmatched += count_buffer(scanner, buf, size,
+                                               worker->stats.kindCounts);
+  } else {
+    worker->stats.numUnmatched += scan_buffer(scanner, buf, size, baseOffset,
+                                              tokens);
+    worker->stats.numTokens += tokens->size;
+  }
+}
+
+static void init_piece_tokens(TokenBufferPtr tokens) {
+  if (options->captureTags) {
+    init_tagged_token_buffer(tokens, scanner->numTags);
+  } else {
+    init_token_buffer(tokens);
+  }
+
+  tokens->decodeValues = options->decodeValues;
+  tokens->symbols = options->symbols;
+}
+
+/// Cuts the file roughly every chunkSize bytes, right after the first
+/// separator byte at or following the cut. No token spans a separator,
+/// hence, scanning the chunks independently gives the same tokens as
+/// scanning the whole file. That doesn't hold for specs with several
+/// modes since the mode a chunk starts in isn't known, such files are
+/// scanned as a single chunk.
+static void split_file(FileJobPtr file) {
+  int maxChunks = (int)(file->input.size / options->chunkSize) + 1;
+  file->chunkStarts = malloc((maxChunks+1)*sizeof(long));
+  assert(file->chunkStarts != NULL && "Out of memory!\n");
+  file->chunkStarts[0] = 0;
+  file->numChunks = 1;
+
+  long cut = scanner->numModes > 1 ? file->input.size : options->chunkSize;
+
+  while (cut < file->input.size) {
+    while (cut < file->input.size
+           && !scanner->separators[(unsigned char)file->input.buf[cut]]) {
+      cut++;
+    }
+
+    if (cut + 1 >= file->input.size) {
+      break;
+    }
+
+    file->chunkStarts[file->numChunks++] = cut + 1;
+    cut += 1 + options->chunkSize;
+  }
+
+  file->chunkStarts[file->numChunks] = file->input.size;
+  file->chunkTokens = malloc(file->numChunks*sizeof(TokenBuffer));
+  assert(file->chunkTokens != NULL && "Out of memory!\n");
+
+  for (int i=0 ; i<file->numChunks ; i++) {
+    init_piece_tokens(file->chunkTokens + i);
+  }
+
+  atomic_store(&file->remainingChunks, file->numChunks);
+}
+
+static bool write_file_tokens(FileJobPtr file, TokenBuffer *chunkTokens,
+                              int numChunks) {
+  char outPath[MAX_PATH_LEN];
+  output_path(file, outPath);
+  FILE *out = fopen(outPath, "w");
+
+  if (out == NULL) {
+    fprintf(stderr, "Error: cannot write %s\n", outPath);
+    return FALSE;
+  }
+
+  if (options->format == BINARY_TOKENS) {
+    TokenFileWriter writer;
+    open_token_writer(&writer, out, output_spec_hash());
+
+    for (int i=0 ; i<numChunks ; i++) {
+      write_tokens_binary(&writer, chunkTokens + i);
+    }
+
+    close_token_writer(&writer);
+  } else {
+    for (int i=0 ; i<numChunks ; i++) {
+      write_tokens_text(out, scanner, chunkTokens + i);
+    }
+  }
+
+  fclose(out);
+
+  if (options->cacheDir != NULL) {
+    char cachePath[MAX_PATH_LEN];
+    cache_path(file, cachePath);
+
+    // failing to fill the cache only costs a scan next time
+    copy_file(outPath, cachePath);
+  }
+
+  return TRUE;
+}
+
+/// What the tokens written for an input depend on besides the input
+static uint64_t output_spec_hash() {
+  if (options->searcher != NULL) {
+    return options->searcher->specHash;
+  }
+
+  // the tags and values are part of the token lines
+  uint64_t hash = scanner->specHash;
+
+  if (options->captureTags) {
+    hash = hash_bytes("tags", 4, hash);
+  }
+
+  if (options->decodeValues) {
+    hash = hash_bytes("values", 6, hash);
+  }
+
+  return hash;
+}
+
+static const char *output_extension() {
+  return options->format == BINARY_TOKENS ? ".tokb" : ".tokens";
+}
+
+static void output_path(FileJobPtr file, char *outPath) {
+  if (options->outDir == NULL) {
+    snprintf(outPath, MAX_PATH_LEN, "%s%s", file->input.path,
+             output_extension());
+    return;
+  }
+
+  // flatten the input path so that files with the same name in
+  // different directories don't overwrite each other
+  int len = snprintf(outPath, MAX_PATH_LEN, "%s/", options->outDir);
+
+  for (const char *c=file->input.path ; *c != '\0' && len < MAX_PATH_LEN-8
+         ; c++) {
+    outPath[len++] = *c == '/' ? '_' : *c;
+  }
+
+  strcpy(outPath + len, output_extension());
+}
+
+/// Cache entries are keyed by the spec the tokens were produced with and
+/// the content of the input they were produced for
+static void cache_path(FileJobPtr file, char *cachePath) {
+  snprintf(cachePath, MAX_PATH_LEN, "%s/%016llx-%016llx%s",
+           options->cacheDir, (unsigned long long)output_spec_hash(),
+           (unsigned long long)file->contentHash, output_extension());
+}
+
+/// Copies a file through a temporary file renamed into place, so that a
+/// concurrent reader of toPath (e.g. another batch sharing the cache)
+/// never sees a partial copy
+static bool copy_file(const char *fromPath, const char *toPath) {
+  char tmpPath[MAX_PATH_LEN + 32];
+  char buf[COPY_BUFFER_SIZE];
+  int from = open(fromPath, O_RDONLY);
+
+  if (from < 0) {
+    return FALSE;
+  }
+
+  // unique across the threads and processes sharing the directory
+  snprintf(tmpPath, sizeof(tmpPath), "%s.tmpXXXXXX", toPath);
+  int to = mkstemp(tmpPath);
+  bool ok = to >= 0 && fchmod(to, 0644) == 0;
+  ssize_t n;
+
+  while (ok && (n = read(from, buf, COPY_BUFFER_SIZE)) != 0) {
+    ok = n > 0 && write(to, buf, n) == n;
+  }
+
+  close(from);
+
+  if (to >= 0) {
+    close(to);
+  }
+
+  if (ok && rename(tmpPath, toPath) != 0) {
+    ok = FALSE;
+  }
+
+  if (!ok && to >= 0) {
+    unlink(tmpPath);
+  }
+
+  return ok;
+}
+
+static void release_file(FileJobPtr file) {
+  if (file->loaded) {
+    atomic_fetch_sub(&unscannedBytes,
+                     file->input.buf != NULL ? file->input.size : 0);
+    atomic_fetch_sub(&unscannedFiles, 1);
+  }
+
+  free(file->input.buf);
+  free(file->chunkStarts);
+  free(file->chunkTokens);
+  file->input.buf = NULL;
+  file->chunkStarts = NULL;
+  file->chunkTokens = NULL;
+}
+
+static double now_seconds() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
@@ -0,0 +1,314 @@
+#include "../include/codegen.h"
+
+static int compute_byte_classes(ScannerPtr scanner, int numStates,
+                                int *byteClasses, int *classBytes);
+static uint32_t trail_ops(ScannerPtr scanner, DFAStatePtr state, int c);
+static void emit_token_name(FILE *out, char *name);
+static void emit_modes(FILE *out, ScannerPtr scanner);
+static void emit_tables(FILE *out, ScannerPtr scanner, int numStates,
+                        int numClasses, int *byteClasses, int *classBytes);
+static void emit_scan_function(FILE *out, ScannerPtr scanner);
+
+void emit_c_scanner(FILE *out, ScannerPtr scanner) {
+  int byteClasses[ALPHABET_SIZE];
+  int classBytes[ALPHABET_SIZE];
+  int numStates = scanner->numStates;
+  int numClasses = compute_byte_classes(scanner, numStates, byteClasses,
+                                        classBytes);
+
+  fprintf(out,
+          "/* Generated by al-farahidi, do not edit. See codegen.h for how\n"
+          " * to use this file. */\n\n"
+          "#include <ctype.h>\n\n"
+          "enum {\n");
+
+  for (int i=0 ; i<scanner->nontermTableSize ; i++) {
+    fprintf(out, "  ");
+    emit_token_name(out, scanner->nontermTable[i].name);
+    fprintf(out, ",\n");
+  }
+
+  fprintf(out, "  NUM_TOKENS\n};\n\n");
+  fprintf(out, "static const char *const tokenNames[NUM_TOKENS] = {\n");
+
+  for (int i=0 ; i<scanner->nontermTableSize ; i++) {
+    fprintf(out, "  \"%s\",\n", scanner->nontermTable[i].name);
+  }
+
+  fprintf(out, "};\n\n");
+  emit_modes(out, scanner);
+  emit_tables(out, scanner, numStates, numClasses, byteClasses, classBytes);
+  emit_scan_function(out, scanner);
+}
+
+/// Bytes whose columns are the same in every state, including the
+/// trailing contexts they end, are interchangeable, they get the same
+/// class. classBytes[k] is a byte of class k.
+static int compute_byte_classes(ScannerPtr scanner, int numStates,
+                                int *byteClasses, int *classBytes) {
+  int numClasses = 0;
+
+  for (int c=0 ; c<ALPHABET_SIZE ; c++) {
+    byteClasses[c] = -1;
+
+    for (int k=0 ; k<numClasses && byteClasses[c] == -1 ; k++) {
+      bool same = TRUE;
+
+      for (int s=0 ; s<numStates && same ; s++) {
+        DFAStatePtr state = scanner->states + scanner->start + s;
+        same = state->transitions[c] == state->transitions[classBytes[k]]
+          && trail_ops(scanner, state, c)
+             == trail_ops(scanner, state, classBytes[k]);
+      }
+
+      if (same) {
+        byteClasses[c] = k;
+      }
+    }
+
+    if (byteClasses[c] == -1) {
+      classBytes[numClasses] = c;
+      byteClasses[c] = numClasses++;
+    }
+  }
+
+  return numClasses;
+}
+
+/// The trailing tags (see Tag) crossed by the state's transition on c
+static uint32_t trail_ops(ScannerPtr scanner, DFAStatePtr state, int c) {
+  if (!scanner->hasTrailingContext || state->tagOps == NO_TAG_OPS) {
+    return 0;
+  }
+
+  uint32_t ops = 0;
+
+  for (int t=0 ; t<scanner->numTags ; t++) {
+    if (scanner->tagTable[t].trailing) {
+      ops |= scanner->tagOps[state->tagOps][c] & (1u << t);
+    }
+  }
+
+  return ops;
+}
+
+/// TOKEN_ followed by the name without its $, with the characters that
+/// can't be part of a C identifier replaced by _
+static void emit_token_name(FILE *out, char *name) {
+  fprintf(out, "TOKEN_");
+
+  for (char *c=name+1 ; *c != '\0' ; c++) {
+    fputc(isalnum((unsigned char)*c) ? *c : '_', out);
+  }
+}
+
+/// The MODE_ constants, the start state of every mode, and the mode each
+/// token switches to (-1 to stay in the same mode)
+static void emit_modes(FILE *out, ScannerPtr scanner) {
+  fprintf(out, "enum {\n");
+
+  for (int m=0 ; m<scanner->numModes ; m++) {
+    fprintf(out, "  MODE_%s,\n", scanner->modeTable[m].name);
+  }
+
+  fprintf(out, "  NUM_MODES\n};\n\n");
+  fprintf(out, "static const short modeStarts[NUM_MODES] = {");
+
+  for (int m=0 ; m<scanner->numModes ; m++) {
+    fprintf(out, "%s%d", m == 0 ? "" : ", ",
+            scanner->modes[m].start - scanner->start);
+  }
+
+  fprintf(out, "};\n\n");
+  fprintf(out, "static const short nextModes[NUM_TOKENS] = {");
+
+  for (int i=0 ; i<scanner->nontermTableSize ; i++) {
+    fprintf(out, "%s%d,", i % 16 == 0 ? "\n  " : " ",
+            scanner->nextMode[i]);
+  }
+
+  fprintf(out, "\n};\n\n");
+}
+
+static void emit_tables(FILE *out, ScannerPtr scanner, int numStates,
+                        int numClasses, int *byteClasses, int *classBytes) {
+  fprintf(out, "#define NUM_STATES  %d\n", numStates);
+  fprintf(out, "#define NUM_CLASSES %d\n\n", numClasses);
+  fprintf(out, "static const unsigned char byteClasses[256] = {");
+
+  for (int c=0 ; c<ALPHABET_SIZE ; c++) {
+    fprintf(out, "%s%d,", c % 16 == 0 ? "\n  " : " ", byteClasses[c]);
+  }
+
+  fprintf(out, "\n};\n\n");
+
+  // -1 is the dead state
+  fprintf(out, "static const short transitions[NUM_STATES][NUM_CLASSES] = {\n");
+
+  for (int s=0 ; s<numStates ; s++) {
+    DFAStatePtr state = scanner->states + scanner->start + s;
+    fprintf(out, "  {");
+
+    for (int k=0 ; k<numClasses ; k++) {
+      PoolOffset target = state->transitions[classBytes[k]];
+      fprintf(out, "%s%d", k == 0 ? "" : ", ",
+              target == DEAD_STATE ? -1 : target - scanner->start);
+    }
+
+    fprintf(out, "},\n");
+  }
+
+  fprintf(out, "};\n\n");
+
+  // -1 for states that don't accept
+  fprintf(out, "static const short acceptedTokens[NUM_STATES] = {");
+
+  for (int s=0 ; s<numStates ; s++) {
+    fprintf(out, "%s%d,", s % 16 == 0 ? "\n  " : " ",
+            scanner->states[scanner->start + s].token);
+  }
+
+  fprintf(out, "\n};\n\n");
+
+  if (!scanner->hasTrailingContext) {
+    return;
+  }
+
+  // the trailing tags crossed by every transition and the trailing tag of
+  // every token, -1 for tokens without a trailing context
+  fprintf(out, "#define NUM_TAGS    %d\n\n", scanner->numTags);
+  fprintf(out,
+          "static const unsigned long trailOps[NUM_STATES][NUM_CLASSES] = {\n");
+
+  for (int s=0 ; s<numStates ; s++) {
+    DFAStatePtr state = scanner->states + scanner->start + s;
+    fprintf(out, "  {");
+
+    for (int k=0 ; k<numClasses ; k++) {
+      fprintf(out, "%s%#lx", k == 0 ? "" : ", ",
+              (unsigned long)trail_ops(scanner, state, classBytes[k]));
+    }
+
+    fprintf(out, "},\n");
+  }
+
+  fprintf(out, "};\n\n");
+  fprintf(out, "static const short trailTags[NUM_TOKENS] = {");
+
+  for (int i=0 ; i<scanner->nontermTableSize ; i++) {
+    fprintf(out, "%s%d,", i % 16 == 0 ? "\n  " : " ", scanner->trailTag[i]);
+  }
+
+  fprintf(out, "\n};\n\n");
+}
+
+/// The loop mirrors scan_buffer, except that the actions are emitted as
+/// the cases of a switch on the matched token
+static void emit_scan_function(FILE *out, ScannerPtr scanner) {
+  fprintf(out,
+          "#define BEGIN(m) (mode = (m))\n\n"
+          "static long scan_tokens(const char *buf, long size, void *ctx) {\n"
+          "  long numUnmatched = 0;\n"
+          "  long pos = 0;\n"
+          "  int mode = MODE_INITIAL;\n\n"
+          "  while (pos < size) {\n"
+          "    if (mode == MODE_INITIAL && isspace((unsigned char)buf[pos])) {\n"
+          "      pos++;\n"
+          "      continue;\n"
+          "    }\n\n"
+          "    int state = modeStarts[mode];\n"
+          "    int lastToken = -1;\n"
+          "    long lastEnd = pos + 1;\n");
+
+  // trailing contexts get a register per tag, see scan_buffer
+  bool trailing = scanner->hasTrailingContext;
+
+  if (trailing) {
+    fprintf(out,
+            "    int regs[NUM_TAGS];\n"
+            "    int lastRegs[NUM_TAGS];\n\n"
+            "    for (int t=0 ; t<NUM_TAGS ; t++) {\n"
+            "      regs[t] = lastRegs[t] = -1;\n"
+            "    }\n");
+  }
+
+  fprintf(out,
+          "\n"
+          "    for (long p=pos ; p<size ; p++) {\n"
+          "      unsigned char c = buf[p];\n");
+
+  if (trailing) {
+    fprintf(out,
+            "      unsigned long ops = trailOps[state][byteClasses[c]];\n\n"
+            "      for (int t=0 ; ops != 0 ; t++, ops >>= 1) {\n"
+            "        if (ops & 1) {\n"
+            "          regs[t] = (int)(p + 1 - pos);\n"
+            "        }\n"
+            "      }\n\n");
+  }
+
+  fprintf(out,
+          "      state = transitions[state][byteClasses[c]];\n\n"
+          "      if (state < 0) {\n"
+          "        break;\n"
+          "      }\n\n"
+          "      if (acceptedTokens[state] >= 0) {\n"
+          "        lastToken = acceptedTokens[state];\n"
+          "        lastEnd = p + 1;\n");
+
+  if (trailing) {
+    fprintf(out,
+            "\n"
+            "        for (int t=0 ; t<NUM_TAGS ; t++) {\n"
+            "          lastRegs[t] = regs[t];\n"
+            "        }\n");
+  }
+
+  fprintf(out,
+          "      }\n"
+          "    }\n\n");
+
+  if (trailing) {
+    fprintf(out,
+            "    if (lastToken >= 0 && trailTags[lastToken] >= 0\n"
+            "        && lastRegs[trailTags[lastToken]] > 0) {\n"
+            "      lastEnd = pos + lastRegs[trailTags[lastToken]];\n"
+            "    }\n\n");
+  }
+
+  fprintf(out,
+          "    const char *lexeme = buf + pos;\n"
+          "    int length = (int)(lastEnd - pos);\n"
+          "    long offset = pos;\n"
+          "    (void)lexeme;\n"
+          "    (void)length;\n"
+          "    (void)offset;\n"
+          "    (void)ctx;\n\n"
+          "    if (lastToken >= 0 && nextModes[lastToken] >= 0) {\n"
+          "      mode = nextModes[lastToken];\n"
+          "    }\n\n"
+          "    switch (lastToken) {\n"
+          "    case -1:\n"
+          "      numUnmatched++;\n"
+          "      break;\n");
+
+  for (int i=0 ; i<scanner->nontermTableSize ; i++) {
+    NonTerminalPtr nonterm = scanner->nontermTable + i;
+
+    if (nonterm->action == NULL) {
+      continue;
+    }
+
+    fprintf(out, "    case ");
+    emit_token_name(out, nonterm->name);
+    fprintf(out, ": {\n      %s\n      break;\n    }\n", nonterm->action);
+  }
+
+  fprintf(out,
+          "    }\n\n"
+          "    pos = lastEnd;\n"
+          "  }\n\n"
+          "  return numUnmatched;\n"
+          "}\n\n"
+          "#undef BEGIN\n");
+}
@@ -0,0 +1,173 @@
+#include "../include/decode.h"
+
+/// Runs of 8 digits are decoded at once using SWAR (SIMD within a
+/// register): the 8 bytes are loaded into a 64-bit word and every step
+/// combines adjacent lanes, halving their number. For more details check
+/// "Hacker's Delight", 2nd Edition, Section 2-18 and
+/// http://0x80.pl/articles/simd-parsing-int-sequences.html
+///
+/// The lane arithmetic assumes the first byte of the run is the least
+/// significant one, hence, big endian targets always take the byte at a
+/// time path.
+
+#define ONES 0x0101010101010101ULL
+#define HIGH_BITS (0x80 * ONES)
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define SWAR_DECODING 1
+#else
+#define SWAR_DECODING 0
+#endif
+
+static uint64_t load64(const char *p);
+static uint64_t bytes_in_range(uint64_t x, unsigned char lo,
+                               unsigned char hi);
+static int hex_digit_value(unsigned char c);
+static int decode_escape(const char *buf, long size, long *pos);
+
+uint64_t decode_decimal(const char *buf, long size) {
+  uint64_t value = 0;
+  long pos = 0;
+
+  while (pos < size) {
+#if SWAR_DECODING
+    if (size - pos >= 8) {
+      uint64_t x = load64(buf + pos);
+
+      if (bytes_in_range(x, '0', '9') == HIGH_BITS) {
+        x -= '0' * ONES;
+        // 8 lanes of 1 digit -> 4 lanes of 2 digits -> 2 of 4 -> 1 of 8
+        x = (x * 10 + (x >> 8)) & 0x00FF00FF00FF00FFULL;
+        x = (x * 100 + (x >> 16)) & 0x0000FFFF0000FFFFULL;
+        x = (x * 10000 + (x >> 32)) & 0xFFFFFFFFULL;
+        value = value * 100000000 + x;
+        pos += 8;
+        continue;
+      }
+    }
+#endif
+
+    unsigned char c = buf[pos++];
+
+    if (c >= '0' && c <= '9') {
+      value = value * 10 + (c - '0');
+    }
+  }
+
+  return value;
+}
+
+uint64_t decode_hex(const char *buf, long size) {
+  uint64_t value = 0;
+  long pos = 0;
+
+  while (pos < size) {
+#if SWAR_DECODING
+    if (size - pos >= 8) {
+      uint64_t x = load64(buf + pos);
+      uint64_t isHex = bytes_in_range(x, '0', '9')
+        | bytes_in_range(x | 0x20 * ONES, 'a', 'f');
+
+      if (isHex == HIGH_BITS) {
+        // a digit's value is its low nibble, plus 9 for letters which
+        // are the only ones with bit 6 set
+        x = (x & 0x0F * ONES) + 9 * ((x >> 6) & ONES);
+        x = ((x & 0x000F000F000F000FULL) << 4)
+          | ((x >> 8) & 0x000F000F000F000FULL);
+        x = ((x & 0x000000FF000000FFULL) << 8)
+          | ((x >> 16) & 0x000000FF000000FFULL);
+        x = ((x & 0xFFFF) << 16) | ((x >> 32) & 0xFFFF);
+        value = (value << 32) | x;
+        pos += 8;
+        continue;
+      }
+    }
+#endif
+
+    int digit = hex_digit_value(buf[pos++]);
+
+    if (digit != -1) {
+      value = value * 16 + digit;
+    }
+  }
+
+  return value;
+}
+
+int decode_char(const char *buf, long size) {
+  long pos = 1;
+
+  if (size < 3) {
+    return 0;
+  }
+
+  return decode_escape(buf, size - 1, &pos);
+}
+
+long decode_string(const char *buf, long size, char *out) {
+  long len = 0;
+  long pos = 1;
+
+  while (pos < size - 1) {
+    out[len++] = (char)decode_escape(buf, size - 1, &pos);
+  }
+
+  out[len] = '\0';
+  return len;
+}
+
+/// Decodes the character at *pos, which might be a \ escape, and moves
+/// *pos past it
+static int decode_escape(const char *buf, long size, long *pos) {
+  unsigned char c = buf[(*pos)++];
+
+  if (c != '\\' || *pos == size) {
+    return c;
+  }
+
+  c = buf[(*pos)++];
+
+  switch (c) {
+  case 'n':
+    return '\n';
+  case 't':
+    return '\t';
+  case 'r':
+    return '\r';
+  default:
+    // \\, \' and \" as well as unknown escapes stand for the character
+    return c;
+  }
+}
+
+static int hex_digit_value(unsigned char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+
+  c |= 0x20;
+
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+
+  return -1;
+}
+
+static uint64_t load64(const char *p) {
+  uint64_t x;
+  memcpy(&x, p, sizeof(x));
+  return x;
+}
+
+/// Returns a word with the high bit of every byte of x in [lo, hi] set.
+/// Bytes >= 0x80 are never in range, which keeps the additions from
+/// carrying into the next byte.
+static uint64_t bytes_in_range(uint64_t x, unsigned char lo,
+                               unsigned char hi) {
+  uint64_t ascii = ~x & HIGH_BITS;
+  uint64_t low7 = x & ~HIGH_BITS;
+  uint64_t geLo = low7 + (0x80 - lo) * ONES;
+  uint64_t gtHi = low7 + (0x7F - hi) * ONES;
+  return geLo & ~gtHi & ascii & HIGH_BITS;
+}
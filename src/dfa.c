@@ -0,0 +1,748 @@
+#include "../include/dfa.h"
+#include "../include/artifacts.h"
+
+/// This is an implementation of the subset construction to obtain DFAs
+/// from NFAs. For more details check "Engineering a Compiler", 2011,
+/// Section 2.4.3
+///
+/// Each DFA state stands for the (sorted) set of NFA states reachable
+/// after reading some prefix of the input. The sets are only needed
+/// while the DFA is under construction, hence, their storage is reused
+/// from one call to build_dfa to the next.
+///
+/// Tags are handled like in Laurikari's tagged DFAs, simplified to a
+/// single register per tag: every transition records the tags its epsilon
+/// closure crosses, and the scanner stores the current position in the
+/// registers of those tags. A tag inside a loop hence reports the last
+/// position it was crossed at.
+
+#define INITIAL_NFA_SET_POOL (1 << 21)
+#define MAX_NFA_SET_POOL     (1 << 23)
+// a range edge (see NFAEdge) adds a move per byte in its range
+#define INITIAL_MOVES        (1 << 16)
+#define MAX_MOVES            (1 << 20)
+// enough for every transition of 32K states
+#define INITIAL_MIN_MOVES    (1 << 20)
+#define MAX_MIN_MOVES        (1 << 23)
+
+/// Like the NFA pools, the pools below are allocated on demand and grow
+/// as needed (see grow_capacity), which moves them. The arrays indexed
+/// by DFA state grow along with the states pool, see
+/// grow_dfa_states_pool, and the ones indexed by NFA state cover the NFA
+/// states pool as of the last call to build_dfa.
+static DFAStatePtr dfaStatesPool = NULL;
+static int maxDFAStates = 0;
+static PoolOffset currentDFAState = 0;
+// the first state of the DFA under construction
+static PoolOffset firstDFAState;
+
+static DFA dfaPool[MAX_DFAS];
+static PoolOffset currentDFA = 0;
+
+static TagOpsRow *tagOpsPool = NULL;
+static int maxTagOpsRows = 0;
+static PoolOffset currentTagOpsRow = 0;
+
+/// A memory pool for storing the NFA state sets of the DFA states under
+/// construction. Sets are stored back to back.
+static PoolOffset *nfaSetPool = NULL;
+static int maxNFASetEntries = 0;
+static PoolOffset currentNFASetEntry = 0;
+static PoolOffset *dfaStateSet = NULL;
+static int *dfaStateSetSize = NULL;
+
+// open addressing hash table from NFA state sets to DFA states, -1 marks
+// an empty slot. It has twice as many slots as the states pool.
+static PoolOffset *dfaStateHashTable = NULL;
+static int dfaHashSize = 0;
+
+static NFAStatePtr nfaStateTable;
+static NFAEdgePtr nfaEdgeTable;
+static int maxNFAStates = 0;
+
+// Maps an NFA state to the non-terminal it accepts or NO_TOKEN
+static int *nfaStateToken = NULL;
+
+// closure_of marks the NFA states it already added to the set being
+// built with the current value of closureMark instead of clearing a
+// boolean array for every new set
+static int *closureMarks = NULL;
+static int closureMark = 0;
+static PoolOffset *closureStack = NULL;
+// the tags crossed by the last call to closure_of
+static uint32_t closureTags;
+
+// minimize_dfa's partition of the states of the DFA being minimized,
+// indexed relative to its start state. minRepresentative[k] is the first
+// state of class k.
+static int *minClass = NULL;
+static int *minNewClass = NULL;
+static PoolOffset *minRepresentative = NULL;
+static PoolOffset minFirstState;
+// the live transitions of the DFA being minimized, the ones of state s
+// (relative to its start state) are at [minMoveStart[s], minMoveStart[s+1]).
+// Refining the partition only looks at these, most states of a big DFA,
+// e.g. a dictionary's (see load_dictionary), have a few of the 256.
+static unsigned char *minMoveSymbols = NULL;
+static PoolOffset *minMoveTargets = NULL;
+static int maxMinMoves = 0;
+static int *minMoveStart = NULL;
+
+// scratch storage for the (symbol, target) pairs leaving a set of NFA
+// states, bucketed by symbol
+static PoolOffset *moveTargets = NULL;
+static unsigned char *moveSymbols = NULL;
+static PoolOffset *moveBuckets = NULL;
+static int maxMoves = 0;
+
+static void grow_dfa_states_pool();
+static void rehash_dfa_states();
+static void grow_nfa_state_arrays(int numNFAStates);
+static void grow_nfa_set_pool(int needed);
+static void grow_tag_ops_pool();
+static int closure_of(PoolOffset *seeds, int numSeeds);
+static PoolOffset find_or_add_dfa_state(int setSize);
+static void build_dfa_state_transitions(PoolOffset dfaStateIdx);
+static void set_tag_ops(PoolOffset dfaStateIdx, int symbol, uint32_t tags);
+static void minimize_dfa(PoolOffset dfaIdx);
+static int refine_classes(PoolOffset first, int numStates, bool initial);
+static unsigned int hash_state_signature(PoolOffset stateIdx, bool initial);
+static bool same_state_signature(PoolOffset s1, PoolOffset s2, bool initial);
+static uint32_t transition_tags(DFAStatePtr state, int symbol);
+static unsigned int hash_nfa_set(PoolOffset *set, int setSize);
+static int compare_offsets(const void *a, const void *b);
+static PoolOffset load_dfa(const char *cacheDir, uint64_t key);
+static void save_dfa(PoolOffset dfaIdx, const char *cacheDir, uint64_t key);
+
+PoolOffset build_dfa(NFAStatePtr _nfaStateTable, NFAEdgePtr _nfaEdgeTable,
+                     NFAPtr nfaTable, PoolOffset nfaIdx,
+                     DFAStatePtr *dfaStateTable, DFAPtr *dfaTable) {
+  nfaStateTable = _nfaStateTable;
+  nfaEdgeTable = _nfaEdgeTable;
+  NFAPtr nfa = nfaTable + nfaIdx;
+
+  if (maxNFAStates < get_num_nfa_states()) {
+    grow_nfa_state_arrays(get_num_nfa_states());
+  }
+
+  if (dfaStatesPool == NULL) {
+    grow_dfa_states_pool();
+  }
+
+  // NO_TOKEN is -1, see build_nfa for why memset works here
+  memset(nfaStateToken, -1, maxNFAStates*sizeof(int));
+  memset(dfaStateHashTable, -1, dfaHashSize*sizeof(PoolOffset));
+  currentNFASetEntry = 0;
+
+  for (int i=0 ; i<nfa->numAccepting ; i++) {
+    if (nfa->accepting[i] != NO_STATE) {
+      nfaStateToken[nfa->accepting[i]] = i;
+    }
+  }
+
+  assert(currentDFA < MAX_DFAS && "DFA pool ran out of memory!\n");
+  PoolOffset dfaIdx = currentDFA++;
+  firstDFAState = currentDFAState;
+
+  int setSize = closure_of(&nfa->start, 1);
+  dfaPool[dfaIdx].start = find_or_add_dfa_state(setSize);
+  dfaPool[dfaIdx].startTags = closureTags;
+
+  // new states are appended to the pool as they are discovered, which
+  // makes the pool itself the work list
+  for (PoolOffset s=firstDFAState ; s<currentDFAState ; s++) {
+    build_dfa_state_transitions(s);
+  }
+
+  dfaPool[dfaIdx].numStates = currentDFAState - firstDFAState;
+  minimize_dfa(dfaIdx);
+
+  if (dfaStateTable != NULL) {
+    *dfaStateTable = dfaStatesPool;
+    *dfaTable = dfaPool;
+  }
+
+  return dfaIdx;
+}
+
+PoolOffset build_cached_dfa(NFAStatePtr nfaStateTable, NFAEdgePtr nfaEdgeTable,
+                            NFAPtr nfaTable, PoolOffset nfaIdx,
+                            DFAStatePtr *dfaStateTable, DFAPtr *dfaTable,
+                            const char *cacheDir, uint64_t key) {
+  PoolOffset dfaIdx = load_dfa(cacheDir, key);
+
+  if (dfaIdx == -1) {
+    dfaIdx = build_dfa(nfaStateTable, nfaEdgeTable, nfaTable, nfaIdx, NULL,
+                       NULL);
+    save_dfa(dfaIdx, cacheDir, key);
+  }
+
+  if (dfaStateTable != NULL) {
+    *dfaStateTable = dfaStatesPool;
+    *dfaTable = dfaPool;
+  }
+
+  return dfaIdx;
+}
+
+TagOpsRow *get_tag_ops_table() {
+  return tagOpsPool;
+}
+
+/// Computes the epsilon closure of the seed states and stores it sorted
+/// at the end of nfaSetPool, see find_or_add_dfa_state. Returns the size
+/// of the closure. The tags of the crossed edges are stored in
+/// closureTags.
+static int closure_of(PoolOffset *seeds, int numSeeds) {
+  int setSize = 0;
+  int stackSize = 0;
+  closureMark++;
+  closureTags = 0;
+
+  for (int i=0 ; i<numSeeds ; i++) {
+    if (closureMarks[seeds[i]] != closureMark) {
+      closureMarks[seeds[i]] = closureMark;
+      closureStack[stackSize++] = seeds[i];
+    }
+  }
+
+  while (stackSize > 0) {
+    PoolOffset stateIdx = closureStack[--stackSize];
+    NFAStatePtr state = nfaStateTable + stateIdx;
+
+    if (currentNFASetEntry + setSize == maxNFASetEntries) {
+      grow_nfa_set_pool(currentNFASetEntry + setSize + 1);
+    }
+
+    nfaSetPool[currentNFASetEntry + setSize++] = stateIdx;
+
+    for (int i=0 ; i<state->numEdges ; i++) {
+      NFAEdgePtr edge = nfaEdgeTable + state->edges[i];
+
+      // a tagged edge counts even if its target was already reached
+      // through another path
+      if (edge->symbol == EPSILON && edge->tag != NO_TAG) {
+        closureTags |= 1u << edge->tag;
+      }
+
+      if (edge->symbol == EPSILON && closureMarks[edge->target] != closureMark) {
+        closureMarks[edge->target] = closureMark;
+        closureStack[stackSize++] = edge->target;
+      }
+    }
+  }
+
+  qsort(nfaSetPool + currentNFASetEntry, setSize, sizeof(PoolOffset),
+        compare_offsets);
+  return setSize;
+}
+
+/// Looks up the DFA state standing for the set of NFA states stored at
+/// the end of nfaSetPool. If it's a new one, it's kept there and a new
+/// DFA state is created for it.
+static PoolOffset find_or_add_dfa_state(int setSize) {
+  PoolOffset *set = nfaSetPool + currentNFASetEntry;
+  unsigned int hash = hash_nfa_set(set, setSize);
+  unsigned int slot = hash % dfaHashSize;
+
+  while (dfaStateHashTable[slot] != -1) {
+    PoolOffset candidate = dfaStateHashTable[slot];
+
+    if (dfaStateSetSize[candidate] == setSize
+        && memcmp(nfaSetPool + dfaStateSet[candidate], set,
+                  setSize*sizeof(PoolOffset)) == 0) {
+      return candidate;
+    }
+
+    slot = (slot + 1) % dfaHashSize;
+  }
+
+  if (currentDFAState == maxDFAStates) {
+    grow_dfa_states_pool();
+    rehash_dfa_states();
+    slot = hash % dfaHashSize;
+
+    while (dfaStateHashTable[slot] != -1) {
+      slot = (slot + 1) % dfaHashSize;
+    }
+  }
+
+  PoolOffset stateIdx = currentDFAState++;
+  DFAStatePtr state = dfaStatesPool + stateIdx;
+  dfaStateSet[stateIdx] = set - nfaSetPool;
+  dfaStateSetSize[stateIdx] = setSize;
+  currentNFASetEntry += setSize;
+  dfaStateHashTable[slot] = stateIdx;
+
+  state->token = NO_TOKEN;
+  state->tagOps = NO_TAG_OPS;
+  state->decoder = NO_DECODER;
+
+  for (int i=0 ; i<setSize ; i++) {
+    int token = nfaStateToken[set[i]];
+
+    if (token != NO_TOKEN && (state->token == NO_TOKEN || token < state->token)) {
+      state->token = token;
+    }
+  }
+
+  // only a literal that's part of the accepted token counts, e.g. an
+  // identifier inside a keyword's state isn't decoded
+  for (int i=0 ; i<setSize && state->token != NO_TOKEN ; i++) {
+    NFAStatePtr nfaState = nfaStateTable + set[i];
+
+    if (nfaState->decoder != NO_DECODER && nfaState->owner == state->token) {
+      state->decoder = nfaState->decoder;
+      break;
+    }
+  }
+
+  return stateIdx;
+}
+
+static void build_dfa_state_transitions(PoolOffset dfaStateIdx) {
+  int bucketStart[ALPHABET_SIZE+1];
+  int numMoves = 0;
+
+  memset(bucketStart, 0, sizeof(bucketStart));
+
+  for (int i=0 ; i<dfaStateSetSize[dfaStateIdx] ; i++) {
+    NFAStatePtr nfaState = nfaStateTable
+      + nfaSetPool[dfaStateSet[dfaStateIdx] + i];
+
+    for (int j=0 ; j<nfaState->numEdges ; j++) {
+      NFAEdgePtr edge = nfaEdgeTable + nfaState->edges[j];
+
+      if (edge->symbol == EPSILON) {
+        continue;
+      }
+
+      for (int c=(unsigned char)edge->symbol ; c<=(unsigned char)edge->last
+             ; c++) {
+        if (numMoves == maxMoves) {
+        int capacity = grow_capacity(maxMoves, numMoves + 1, INITIAL_MOVES,
+                                     MAX_MOVES, "moves of a DFA state");
+        moveTargets = resize_pool(moveTargets, maxMoves, capacity,
+                                  sizeof(PoolOffset));
+        moveSymbols = resize_pool(moveSymbols, maxMoves, capacity,
+                                  sizeof(unsigned char));
+        moveBuckets = resize_pool(moveBuckets, maxMoves, capacity,
+                                  sizeof(PoolOffset));
+        maxMoves = capacity;
+      }
+
+        moveSymbols[numMoves] = (unsigned char)c;
+        moveTargets[numMoves] = edge->target;
+        bucketStart[c+1]++;
+        numMoves++;
+      }
+    }
+  }
+
+  // bucket the targets by symbol (counting sort)
+  for (int c=0 ; c<ALPHABET_SIZE ; c++) {
+    bucketStart[c+1] += bucketStart[c];
+  }
+
+  int bucketFill[ALPHABET_SIZE];
+  memcpy(bucketFill, bucketStart, sizeof(bucketFill));
+
+  for (int i=0 ; i<numMoves ; i++) {
+    moveBuckets[bucketFill[moveSymbols[i]]++] = moveTargets[i];
+  }
+
+  for (int c=0 ; c<ALPHABET_SIZE ; c++) {
+    PoolOffset target = DEAD_STATE;
+    int bucketSize = bucketStart[c+1] - bucketStart[c];
+
+    if (bucketSize > 0) {
+      int setSize = closure_of(moveBuckets + bucketStart[c], bucketSize);
+      uint32_t tags = closureTags;
+      target = find_or_add_dfa_state(setSize);
+
+      if (tags != 0) {
+        set_tag_ops(dfaStateIdx, c, tags);
+      }
+    }
+
+    dfaStatesPool[dfaStateIdx].transitions[c] = target;
+  }
+}
+
+/// Merges equivalent states using Moore's partition refinement. States
+/// start out grouped by what they accept, and a group is split as long
+/// as its states disagree on the group of the target, or the tags, of
+/// some transition. For more details check "Engineering a Compiler",
+/// 2011, Section 2.4.4
+///
+/// The groups become the states of the minimal DFA, which are written
+/// over the original ones. Groups are numbered in the order their first
+/// state appears, hence, the start state stays first and every group's
+/// first state is at or after its new position, i.e. it's read before
+/// it's overwritten.
+static void minimize_dfa(PoolOffset dfaIdx) {
+  DFAPtr dfa = dfaPool + dfaIdx;
+  minFirstState = dfa->start;
+  int numMoves = 0;
+
+  for (int s=0 ; s<dfa->numStates ; s++) {
+    DFAStatePtr state = dfaStatesPool + dfa->start + s;
+    minMoveStart[s] = numMoves;
+
+    for (int c=0 ; c<ALPHABET_SIZE ; c++) {
+      if (state->transitions[c] != DEAD_STATE) {
+        if (numMoves == maxMinMoves) {
+          int capacity = grow_capacity(maxMinMoves, numMoves + 1,
+                                       INITIAL_MIN_MOVES, MAX_MIN_MOVES,
+                                       "DFA transitions to minimize");
+          minMoveSymbols = resize_pool(minMoveSymbols, maxMinMoves, capacity,
+                                       sizeof(unsigned char));
+          minMoveTargets = resize_pool(minMoveTargets, maxMinMoves, capacity,
+                                       sizeof(PoolOffset));
+          maxMinMoves = capacity;
+        }
+
+        minMoveSymbols[numMoves] = (unsigned char)c;
+        minMoveTargets[numMoves] = state->transitions[c] - dfa->start;
+        numMoves++;
+      }
+    }
+  }
+
+  minMoveStart[dfa->numStates] = numMoves;
+  int numClasses = refine_classes(dfa->start, dfa->numStates, TRUE);
+
+  while (TRUE) {
+    int numNewClasses = refine_classes(dfa->start, dfa->numStates, FALSE);
+
+    if (numNewClasses == numClasses) {
+      break;
+    }
+
+    numClasses = numNewClasses;
+  }
+
+  for (int k=0 ; k<numClasses ; k++) {
+    DFAState state = dfaStatesPool[minRepresentative[k]];
+
+    for (int c=0 ; c<ALPHABET_SIZE ; c++) {
+      if (state.transitions[c] != DEAD_STATE) {
+        state.transitions[c] = dfa->start
+          + minClass[state.transitions[c] - dfa->start];
+      }
+    }
+
+    dfaStatesPool[dfa->start + k] = state;
+  }
+
+  dfa->numStates = numClasses;
+  currentDFAState = dfa->start + numClasses;
+}
+
+/// Computes the next partition into minClass and returns its number of
+/// classes. The initial partition only looks at what states accept.
+static int refine_classes(PoolOffset first, int numStates, bool initial) {
+  int numClasses = 0;
+
+  // dfaStateHashTable is free once the subset construction is done
+  memset(dfaStateHashTable, -1, dfaHashSize*sizeof(PoolOffset));
+
+  for (int s=0 ; s<numStates ; s++) {
+    unsigned int slot = hash_state_signature(first + s, initial)
+      % dfaHashSize;
+
+    while (dfaStateHashTable[slot] != -1
+           && !same_state_signature(dfaStateHashTable[slot], first + s,
+                                    initial)) {
+      slot = (slot + 1) % dfaHashSize;
+    }
+
+    if (dfaStateHashTable[slot] == -1) {
+      dfaStateHashTable[slot] = first + s;
+      minRepresentative[numClasses] = first + s;
+      minNewClass[s] = numClasses++;
+    } else {
+      minNewClass[s] = minNewClass[dfaStateHashTable[slot] - first];
+    }
+  }
+
+  memcpy(minClass, minNewClass, numStates*sizeof(int));
+  return numClasses;
+}
+
+static unsigned int hash_state_signature(PoolOffset stateIdx, bool initial) {
+  DFAStatePtr state = dfaStatesPool + stateIdx;
+  unsigned int hash = 2166136261u;
+  hash = (hash ^ (unsigned int)state->token) * 16777619u;
+  hash = (hash ^ (unsigned int)state->decoder) * 16777619u;
+
+  if (initial) {
+    return hash;
+  }
+
+  int s = stateIdx - minFirstState;
+  hash = (hash ^ (unsigned int)minClass[s]) * 16777619u;
+
+  for (int m=minMoveStart[s] ; m<minMoveStart[s+1] ; m++) {
+    hash = (hash ^ minMoveSymbols[m]) * 16777619u;
+    hash = (hash ^ (unsigned int)minClass[minMoveTargets[m]]) * 16777619u;
+    hash = (hash ^ transition_tags(state, minMoveSymbols[m])) * 16777619u;
+  }
+
+  return hash;
+}
+
+static bool same_state_signature(PoolOffset s1, PoolOffset s2, bool initial) {
+  DFAStatePtr state1 = dfaStatesPool + s1;
+  DFAStatePtr state2 = dfaStatesPool + s2;
+
+  if (state1->token != state2->token || state1->decoder != state2->decoder) {
+    return FALSE;
+  }
+
+  if (initial) {
+    return TRUE;
+  }
+
+  int m1 = minMoveStart[s1 - minFirstState];
+  int m2 = minMoveStart[s2 - minFirstState];
+  int numMoves = minMoveStart[s1 - minFirstState + 1] - m1;
+
+  if (minClass[s1 - minFirstState] != minClass[s2 - minFirstState]
+      || minMoveStart[s2 - minFirstState + 1] - m2 != numMoves) {
+    return FALSE;
+  }
+
+  for (int i=0 ; i<numMoves ; i++) {
+    int c = minMoveSymbols[m1 + i];
+
+    if (c != minMoveSymbols[m2 + i]
+        || minClass[minMoveTargets[m1 + i]] != minClass[minMoveTargets[m2 + i]]
+        || transition_tags(state1, c) != transition_tags(state2, c)) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+static uint32_t transition_tags(DFAStatePtr state, int symbol) {
+  return state->tagOps == NO_TAG_OPS ? 0 : tagOpsPool[state->tagOps][symbol];
+}
+
+/// Records the tags crossed by a transition, allocating the state's row
+/// on its first tagged transition
+static void set_tag_ops(PoolOffset dfaStateIdx, int symbol, uint32_t tags) {
+  DFAStatePtr state = dfaStatesPool + dfaStateIdx;
+
+  if (state->tagOps == NO_TAG_OPS) {
+    if (currentTagOpsRow == maxTagOpsRows) {
+      grow_tag_ops_pool();
+    }
+
+    state->tagOps = currentTagOpsRow++;
+    memset(tagOpsPool[state->tagOps], 0, sizeof(TagOpsRow));
+  }
+
+  tagOpsPool[state->tagOps][symbol] = tags;
+}
+
+/// Grows the states pool, and the arrays indexed by DFA state along with
+/// it, to make room for one more state. The hash table is reallocated
+/// empty, see rehash_dfa_states.
+static void grow_dfa_states_pool() {
+  int capacity = grow_capacity(maxDFAStates, currentDFAState + 1,
+                               INITIAL_DFA_STATES, MAX_DFA_STATES,
+                               "DFA states");
+  dfaStatesPool = resize_pool(dfaStatesPool, maxDFAStates, capacity,
+                              sizeof(DFAState));
+  dfaStateSet = resize_pool(dfaStateSet, maxDFAStates, capacity,
+                            sizeof(PoolOffset));
+  dfaStateSetSize = resize_pool(dfaStateSetSize, maxDFAStates, capacity,
+                                sizeof(int));
+  minClass = resize_pool(minClass, maxDFAStates, capacity, sizeof(int));
+  minNewClass = resize_pool(minNewClass, maxDFAStates, capacity,
+                            sizeof(int));
+  minRepresentative = resize_pool(minRepresentative, maxDFAStates, capacity,
+                                  sizeof(PoolOffset));
+  minMoveStart = resize_pool(minMoveStart, maxDFAStates + 1, capacity + 1,
+                             sizeof(int));
+  maxDFAStates = capacity;
+
+  free(dfaStateHashTable);
+  dfaHashSize = 2 * capacity;
+  dfaStateHashTable = malloc(dfaHashSize*sizeof(PoolOffset));
+  assert(dfaStateHashTable != NULL && "Out of memory!\n");
+  memset(dfaStateHashTable, -1, dfaHashSize*sizeof(PoolOffset));
+}
+
+/// Adds the states of the DFA under construction to the hash table
+static void rehash_dfa_states() {
+  for (PoolOffset s=firstDFAState ; s<currentDFAState ; s++) {
+    unsigned int slot = hash_nfa_set(nfaSetPool + dfaStateSet[s],
+                                     dfaStateSetSize[s]) % dfaHashSize;
+
+    while (dfaStateHashTable[slot] != -1) {
+      slot = (slot + 1) % dfaHashSize;
+    }
+
+    dfaStateHashTable[slot] = s;
+  }
+}
+
+/// Makes the arrays indexed by NFA state cover the first numNFAStates
+static void grow_nfa_state_arrays(int numNFAStates) {
+  nfaStateToken = resize_pool(nfaStateToken, maxNFAStates, numNFAStates,
+                              sizeof(int));
+  closureMarks = resize_pool(closureMarks, maxNFAStates, numNFAStates,
+                             sizeof(int));
+  closureStack = resize_pool(closureStack, maxNFAStates, numNFAStates,
+                             sizeof(PoolOffset));
+  maxNFAStates = numNFAStates;
+}
+
+static void grow_nfa_set_pool(int needed) {
+  int capacity = grow_capacity(maxNFASetEntries, needed, INITIAL_NFA_SET_POOL,
+                               MAX_NFA_SET_POOL,
+                               "entries in the NFA state sets");
+  nfaSetPool = resize_pool(nfaSetPool, maxNFASetEntries, capacity,
+                           sizeof(PoolOffset));
+  maxNFASetEntries = capacity;
+}
+
+static void grow_tag_ops_pool() {
+  int capacity = grow_capacity(maxTagOpsRows, currentTagOpsRow + 1,
+                               INITIAL_TAG_OPS_ROWS, MAX_TAG_OPS_ROWS,
+                               "tag ops rows");
+  tagOpsPool = resize_pool(tagOpsPool, maxTagOpsRows, capacity,
+                           sizeof(TagOpsRow));
+  maxTagOpsRows = capacity;
+}
+
+/// FNV-1a over the state indices of the set
+static unsigned int hash_nfa_set(PoolOffset *set, int setSize) {
+  unsigned int hash = 2166136261u;
+
+  for (int i=0 ; i<setSize ; i++) {
+    hash = (hash ^ (unsigned int)set[i]) * 16777619u;
+  }
+
+  return hash;
+}
+
+static int compare_offsets(const void *a, const void *b) {
+  return *(const PoolOffset*)a - *(const PoolOffset*)b;
+}
+
+/// Appends the DFA stored under key to the pools. An artifact stores the
+/// DFA's number of states and start tags, then every state: its token,
+/// decoder, and live transitions, i.e. (byte, target relative to the
+/// start state) pairs, followed by its tag ops row if it has one. Returns
+/// -1, leaving the pools as they were, if there's no valid artifact.
+static PoolOffset load_dfa(const char *cacheDir, uint64_t key) {
+  FILE *in = open_artifact(cacheDir, DFA_ARTIFACT, key);
+
+  if (in == NULL) {
+    return -1;
+  }
+
+  assert(currentDFA < MAX_DFAS && "DFA pool ran out of memory!\n");
+  PoolOffset firstStateIdx = currentDFAState;
+  PoolOffset firstTagOpsRow = currentTagOpsRow;
+  DFAPtr dfa = dfaPool + currentDFA;
+  bool ok = fread(&dfa->numStates, sizeof(int), 1, in) == 1
+    && fread(&dfa->startTags, sizeof(uint32_t), 1, in) == 1
+    && dfa->numStates > 0;
+
+  for (int s=0 ; ok && s<dfa->numStates ; s++) {
+    if (currentDFAState == maxDFAStates) {
+      grow_dfa_states_pool();
+    }
+
+    DFAStatePtr state = dfaStatesPool + currentDFAState++;
+    // token, decoder, has a tag ops row, # transitions
+    int fields[4];
+    PoolOffset moves[2 * ALPHABET_SIZE];
+    ok = fread(fields, sizeof(int), 4, in) == 4 && fields[3] >= 0
+      && fields[3] <= ALPHABET_SIZE
+      && fread(moves, 2*sizeof(PoolOffset), fields[3], in)
+      == (size_t)fields[3];
+
+    if (!ok) {
+      break;
+    }
+
+    state->token = fields[0];
+    state->decoder = (DecoderType)fields[1];
+    state->tagOps = NO_TAG_OPS;
+
+    for (int c=0 ; c<ALPHABET_SIZE ; c++) {
+      state->transitions[c] = DEAD_STATE;
+    }
+
+    for (int i=0 ; ok && i<fields[3] ; i++) {
+      PoolOffset symbol = moves[2*i];
+      PoolOffset target = moves[2*i + 1];
+      ok = symbol >= 0 && symbol < ALPHABET_SIZE && target >= 0
+        && target < dfa->numStates;
+      state->transitions[ok ? symbol : 0] = firstStateIdx + target;
+    }
+
+    if (ok && fields[2]) {
+      if (currentTagOpsRow == maxTagOpsRows) {
+        grow_tag_ops_pool();
+      }
+
+      state->tagOps = currentTagOpsRow++;
+      ok = fread(tagOpsPool[state->tagOps], sizeof(TagOpsRow), 1, in) == 1;
+    }
+  }
+
+  fclose(in);
+
+  if (!ok) {
+    currentDFAState = firstStateIdx;
+    currentTagOpsRow = firstTagOpsRow;
+    return -1;
+  }
+
+  dfa->start = firstStateIdx;
+  return currentDFA++;
+}
+
+static void save_dfa(PoolOffset dfaIdx, const char *cacheDir, uint64_t key) {
+  ArtifactWriter writer;
+
+  if (!begin_artifact(&writer, cacheDir, DFA_ARTIFACT, key)) {
+    return;
+  }
+
+  DFAPtr dfa = dfaPool + dfaIdx;
+  fwrite(&dfa->numStates, sizeof(int), 1, writer.out);
+  fwrite(&dfa->startTags, sizeof(uint32_t), 1, writer.out);
+
+  for (int s=0 ; s<dfa->numStates ; s++) {
+    DFAStatePtr state = dfaStatesPool + dfa->start + s;
+    PoolOffset moves[2 * ALPHABET_SIZE];
+    int numMoves = 0;
+
+    for (int c=0 ; c<ALPHABET_SIZE ; c++) {
+      if (state->transitions[c] != DEAD_STATE) {
+        moves[2*numMoves] = c;
+        moves[2*numMoves + 1] = state->transitions[c] - dfa->start;
+        numMoves++;
+      }
+    }
+
+    int fields[4] = { state->token, state->decoder,
+                      state->tagOps != NO_TAG_OPS, numMoves };
+    fwrite(fields, sizeof(int), 4, writer.out);
+    fwrite(moves, 2*sizeof(PoolOffset), numMoves, writer.out);
+
+    if (state->tagOps != NO_TAG_OPS) {
+      fwrite(tagOpsPool[state->tagOps], sizeof(TagOpsRow), 1, writer.out);
+    }
+  }
+
+  end_artifact(&writer, TRUE);
+}
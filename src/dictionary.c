@@ -0,0 +1,265 @@
+#include "../include/dictionary.h"
+
+// every state on the path has at most an edge per byte
+#define MAX_PATH_EDGES (MAX_WORD_LEN * 256)
+
+// the pools grow as needed, see grow_capacity
+static DictStatePtr dictStatesPool = NULL;
+static int maxDictStates = 0;
+static PoolOffset currentDictState = 0;
+static DictEdgePtr dictEdgesPool = NULL;
+static int maxDictEdges = 0;
+static PoolOffset currentDictEdge = 0;
+static Dictionary dictPool[MAX_DICTS];
+static int currentDict = 0;
+
+/// The register of the dictionary being loaded: the states built so far,
+/// hashed by their finality and edges. Equivalent states of an acyclic
+/// DFA have the same finality and the same edges once their children
+/// are minimal. The table has twice as many slots as the states pool.
+static PoolOffset *registerTable = NULL;
+static int registerSize = 0;
+// the first state of the dictionary being loaded
+static PoolOffset firstDictState;
+
+/// The states of the previous word's path, which can still gain edges.
+/// The edges of the state at depth d start at pathEdges[pathStart[d]],
+/// they all lead to states already built. The edge on prevWord[d] to the
+/// state at depth d+1 is implied.
+static DictEdge pathEdges[MAX_PATH_EDGES];
+static int pathStart[MAX_WORD_LEN + 1];
+static bool pathFinal[MAX_WORD_LEN + 1];
+static int numPathEdges;
+static int pathDepth;
+static unsigned char prevWord[MAX_WORD_LEN];
+
+static void freeze_path(int depth);
+static PoolOffset replace_or_register(int depth);
+static PoolOffset add_state(int depth);
+static void grow_register();
+static unsigned int hash_edges(bool final, DictEdgePtr edges, int numEdges);
+static bool same_as_path_state(PoolOffset stateIdx, int depth);
+
+DictionaryStatus load_dictionary(FILE *in, PoolOffset *dictIdx, long *line) {
+  assert(currentDict < MAX_DICTS && "Dictionary pool ran out of memory!\n");
+  char word[MAX_WORD_LEN + 2];
+  long lineNum = 0;
+  long numWords = 0;
+  firstDictState = currentDictState;
+
+  // states are only shared within a dictionary, which keeps each one's
+  // states contiguous
+  if (registerTable == NULL || registerSize < 2 * maxDictStates) {
+    grow_register();
+  } else {
+    memset(registerTable, -1, registerSize*sizeof(PoolOffset));
+  }
+  numPathEdges = 0;
+  pathDepth = 0;
+  pathStart[0] = 0;
+  pathFinal[0] = FALSE;
+
+  while (fgets(word, sizeof(word), in) != NULL) {
+    lineNum++;
+    int len = strlen(word);
+
+    if (len > 0 && word[len-1] == '\n') {
+      len--;
+    } else if (!feof(in)) {
+      *line = lineNum;
+      return WORD_TOO_LONG;
+    }
+
+    if (len > 0 && word[len-1] == '\r') {
+      len--;
+    }
+
+    if (len > MAX_WORD_LEN) {
+      *line = lineNum;
+      return WORD_TOO_LONG;
+    }
+
+    if (len == 0) {
+      continue;
+    }
+
+    int prefixLen = 0;
+
+    while (prefixLen < len && prefixLen < pathDepth
+           && (unsigned char)word[prefixLen] == prevWord[prefixLen]) {
+      prefixLen++;
+    }
+
+    if (prefixLen == len && prefixLen == pathDepth) {
+      continue;
+    }
+
+    // a prefix of the previous word, or a smaller byte where they differ
+    if (prefixLen == len || (prefixLen < pathDepth
+                             && (unsigned char)word[prefixLen]
+                             < prevWord[prefixLen])) {
+      *line = lineNum;
+      return WORDS_OUT_OF_ORDER;
+    }
+
+    // the previous word's states past the common prefix only lead to
+    // words smaller than this one, no word added later goes through them
+    freeze_path(prefixLen);
+
+    for (int d=prefixLen+1 ; d<=len ; d++) {
+      pathStart[d] = numPathEdges;
+      pathFinal[d] = d == len;
+    }
+
+    memcpy(prevWord + prefixLen, word + prefixLen, len - prefixLen);
+    pathDepth = len;
+    numWords++;
+  }
+
+  freeze_path(0);
+  // no other state can be equivalent to the root of a finite language
+  PoolOffset root = add_state(0);
+
+  *dictIdx = currentDict++;
+  dictPool[*dictIdx].first = firstDictState;
+  dictPool[*dictIdx].root = root;
+  dictPool[*dictIdx].numWords = numWords;
+  return DICTIONARY_OK;
+}
+
+void get_dictionary_tables(DictStatePtr *states, DictEdgePtr *edges,
+                           DictionaryPtr *dicts) {
+  *states = dictStatesPool;
+  *edges = dictEdgesPool;
+  *dicts = dictPool;
+}
+
+/// Replaces the states of the path deeper than depth with registered
+/// ones, deepest first, so that a state's children are always minimal
+/// when it's looked up
+static void freeze_path(int depth) {
+  while (pathDepth > depth) {
+    PoolOffset stateIdx = replace_or_register(pathDepth);
+    numPathEdges = pathStart[pathDepth];
+    pathDepth--;
+
+    assert(numPathEdges < MAX_PATH_EDGES && "Dictionary path ran out of"
+           " memory!\n");
+    pathEdges[numPathEdges].symbol = prevWord[pathDepth];
+    pathEdges[numPathEdges].target = stateIdx;
+    numPathEdges++;
+  }
+}
+
+static PoolOffset replace_or_register(int depth) {
+  unsigned int hash = hash_edges(pathFinal[depth], pathEdges + pathStart[depth],
+                                 numPathEdges - pathStart[depth]);
+  unsigned int slot = hash % registerSize;
+
+  while (registerTable[slot] != -1) {
+    if (same_as_path_state(registerTable[slot], depth)) {
+      return registerTable[slot];
+    }
+
+    slot = (slot + 1) % registerSize;
+  }
+
+  PoolOffset stateIdx = add_state(depth);
+
+  // the register grows along with the states pool, which adds the new
+  // state to it
+  if (registerSize < 2 * maxDictStates) {
+    grow_register();
+  } else {
+    registerTable[slot] = stateIdx;
+  }
+
+  return stateIdx;
+}
+
+/// Copies the state of the path at the given depth to the pools
+static PoolOffset add_state(int depth) {
+  int numEdges = numPathEdges - pathStart[depth];
+
+  if (currentDictState == maxDictStates) {
+    int capacity = grow_capacity(maxDictStates, currentDictState + 1,
+                                 INITIAL_DICT_STATES, MAX_DICT_STATES,
+                                 "dictionary states");
+    dictStatesPool = resize_pool(dictStatesPool, maxDictStates, capacity,
+                                 sizeof(DictState));
+    maxDictStates = capacity;
+  }
+
+  if (currentDictEdge + numEdges > maxDictEdges) {
+    int capacity = grow_capacity(maxDictEdges, currentDictEdge + numEdges,
+                                 INITIAL_DICT_EDGES, MAX_DICT_EDGES,
+                                 "dictionary edges");
+    dictEdgesPool = resize_pool(dictEdgesPool, maxDictEdges, capacity,
+                                sizeof(DictEdge));
+    maxDictEdges = capacity;
+  }
+
+  PoolOffset stateIdx = currentDictState++;
+  dictStatesPool[stateIdx].firstEdge = currentDictEdge;
+  dictStatesPool[stateIdx].numEdges = numEdges;
+  dictStatesPool[stateIdx].final = pathFinal[depth];
+  memcpy(dictEdgesPool + currentDictEdge, pathEdges + pathStart[depth],
+         numEdges*sizeof(DictEdge));
+  currentDictEdge += numEdges;
+  return stateIdx;
+}
+
+/// Reallocates the register with twice as many slots as the states pool
+/// and adds the states of the dictionary being loaded to it
+static void grow_register() {
+  free(registerTable);
+  registerSize = 2 * (maxDictStates > 0 ? maxDictStates
+                      : INITIAL_DICT_STATES);
+  registerTable = malloc(registerSize*sizeof(PoolOffset));
+  assert(registerTable != NULL && "Out of memory!\n");
+  memset(registerTable, -1, registerSize*sizeof(PoolOffset));
+
+  for (PoolOffset s=firstDictState ; s<currentDictState ; s++) {
+    DictStatePtr state = dictStatesPool + s;
+    unsigned int slot = hash_edges(state->final,
+                                   dictEdgesPool + state->firstEdge,
+                                   state->numEdges) % registerSize;
+
+    while (registerTable[slot] != -1) {
+      slot = (slot + 1) % registerSize;
+    }
+
+    registerTable[slot] = s;
+  }
+}
+
+static unsigned int hash_edges(bool final, DictEdgePtr edges, int numEdges) {
+  unsigned int hash = 2166136261u ^ (unsigned int)final;
+
+  for (int e=0 ; e<numEdges ; e++) {
+    hash = (hash ^ edges[e].symbol) * 16777619u;
+    hash = (hash ^ (unsigned int)edges[e].target) * 16777619u;
+  }
+
+  return hash;
+}
+
+static bool same_as_path_state(PoolOffset stateIdx, int depth) {
+  DictStatePtr state = dictStatesPool + stateIdx;
+
+  if (state->final != pathFinal[depth]
+      || state->numEdges != numPathEdges - pathStart[depth]) {
+    return FALSE;
+  }
+
+  for (int e=0 ; e<state->numEdges ; e++) {
+    DictEdgePtr edge = dictEdgesPool + state->firstEdge + e;
+    DictEdgePtr pathEdge = pathEdges + pathStart[depth] + e;
+
+    if (edge->symbol != pathEdge->symbol || edge->target != pathEdge->target) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
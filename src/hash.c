@@ -0,0 +1,98 @@
+#include "../include/hash.h"
+
+/// An implementation of xxHash64, for more details check
+/// https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md
+
+#define PRIME64_1 0x9E3779B185EBCA87ULL
+#define PRIME64_2 0xC2B2AE3D27D4EB4FULL
+#define PRIME64_3 0x165667B19E3779F9ULL
+#define PRIME64_4 0x85EBCA77C2B2AE63ULL
+#define PRIME64_5 0x27D4EB2F165667C5ULL
+
+#define rotl64(x, r) (((x) << (r)) | ((x) >> (64 - (r))))
+
+static uint64_t read64(const unsigned char *p);
+static uint32_t read32(const unsigned char *p);
+static uint64_t round64(uint64_t acc, uint64_t input);
+static uint64_t merge_round64(uint64_t acc, uint64_t val);
+
+uint64_t hash_bytes(const void *data, size_t size, uint64_t seed) {
+  const unsigned char *p = data;
+  const unsigned char *end = p + size;
+  uint64_t hash;
+
+  if (size >= 32) {
+    // 4 independent lanes keep several multiplications in flight
+    uint64_t v1 = seed + PRIME64_1 + PRIME64_2;
+    uint64_t v2 = seed + PRIME64_2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - PRIME64_1;
+
+    do {
+      v1 = round64(v1, read64(p));
+      v2 = round64(v2, read64(p + 8));
+      v3 = round64(v3, read64(p + 16));
+      v4 = round64(v4, read64(p + 24));
+      p += 32;
+    } while (p + 32 <= end);
+
+    hash = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+    hash = merge_round64(hash, v1);
+    hash = merge_round64(hash, v2);
+    hash = merge_round64(hash, v3);
+    hash = merge_round64(hash, v4);
+  } else {
+    hash = seed + PRIME64_5;
+  }
+
+  hash += (uint64_t)size;
+
+  while (p + 8 <= end) {
+    hash ^= round64(0, read64(p));
+    hash = rotl64(hash, 27) * PRIME64_1 + PRIME64_4;
+    p += 8;
+  }
+
+  if (p + 4 <= end) {
+    hash ^= (uint64_t)read32(p) * PRIME64_1;
+    hash = rotl64(hash, 23) * PRIME64_2 + PRIME64_3;
+    p += 4;
+  }
+
+  while (p < end) {
+    hash ^= (*p) * PRIME64_5;
+    hash = rotl64(hash, 11) * PRIME64_1;
+    p++;
+  }
+
+  hash ^= hash >> 33;
+  hash *= PRIME64_2;
+  hash ^= hash >> 29;
+  hash *= PRIME64_3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+// memcpy lets the compiler emit a single unaligned load
+static uint64_t read64(const unsigned char *p) {
+  uint64_t val;
+  memcpy(&val, p, sizeof(val));
+  return val;
+}
+
+static uint32_t read32(const unsigned char *p) {
+  uint32_t val;
+  memcpy(&val, p, sizeof(val));
+  return val;
+}
+
+static uint64_t round64(uint64_t acc, uint64_t input) {
+  acc += input * PRIME64_2;
+  acc = rotl64(acc, 31);
+  return acc * PRIME64_1;
+}
+
+static uint64_t merge_round64(uint64_t acc, uint64_t val) {
+  acc ^= round64(0, val);
+  return acc * PRIME64_1 + PRIME64_4;
+}
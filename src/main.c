@@ -6,17 +6,602 @@
  **************************************************************/
 
 #include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
 #include "../include/regex.h"
 #include "../include/nfa.h"
+#include "../include/dfa.h"
+#include "../include/scanner.h"
+#include "../include/batch.h"
+#include "../include/tokfile.h"
+#include "../include/search.h"
+#include "../include/validate.h"
+#include "../include/reader.h"
+#include "../include/codegen.h"
+#include "../include/passes.h"
+#include "../include/artifacts.h"
+
+#define WATCH_INTERVAL_NS 200000000L
+// the spec and the files it reads, see get_spec_files
+#define MAX_WATCHED_FILES (MAX_SPEC_FILES + 1)
+
+typedef struct WatchedFile {
+  char path[MAX_REGEX_LEN];
+  // the version the last run compiled
+  struct stat last;
+} WatchedFile, *WatchedFilePtr;
+
+// the end of the pipe the child of watch_spec reports its spec's files to
+static int watchPipe = -1;
+
+static void usage(char *prog) {
+  fprintf(stderr,
+          "Usage: %s [options] [< spec]\n"
+          "Reads a regex spec and prints its NFA in graphviz format.\n\n"
+          "Options:\n"
+          "  --spec FILE     read the spec from FILE instead of stdin\n"
+          "  --batch LIST    scan every file listed in LIST (one path per\n"
+          "                  line) and write its tokens to <file>.tokens\n"
+          "  --jobs N        number of scanning threads (default: #cores)\n"
+          "  --out-dir DIR   write the token files to DIR\n"
+          "  --chunk-size N  split files larger than N bytes into chunks\n"
+          "                  scanned in parallel\n"
+          "  --no-uring      read the files with pread instead of io_uring\n"
+          "  --cache DIR     reuse the tokens of inputs already scanned with\n"
+          "                  the same spec, stored in DIR\n"
+          "  --format FMT    token file format: text (default) or binary\n"
+          "  --count         only print the number of tokens of every kind\n"
+          "                  instead of writing token files\n"
+          "  --tags          append the positions of the spec's tags (@#name)\n"
+          "                  to the tokens, text format only\n"
+          "  --values        append the decoded values of literals to the\n"
+          "                  tokens, text format only\n"
+          "  --symbols FILE  with --values, write the symbols interned by\n"
+          "                  [intern] rules to FILE\n"
+          "  --search NAME   only look for the occurrences of non-terminal\n"
+          "                  NAME instead of tokenizing the files\n"
+          "  --validate NAME FILE\n"
+          "                  print the lines of FILE that don't match\n"
+          "                  non-terminal NAME as a whole\n"
+          "  --emit-c FILE   write a C scanner for the spec, running the\n"
+          "                  rules' @{ actions @} inline, to FILE\n"
+          "  --dump-tokens FILE\n"
+          "                  print a binary token file in the text format\n"
+          "  --passes LIST   run the comma separated optimization passes\n"
+          "                  instead of all of them, none to run none\n"
+          "  --list-passes   print the optimization passes and exit\n"
+          "  --pass-stats    print the time every pass took and how it\n"
+          "                  changed the size of the spec or NFAs\n"
+          "  --build-cache DIR\n"
+          "                  reuse the automata of the rules and modes that\n"
+          "                  didn't change since they were stored in DIR,\n"
+          "                  and link the modules the spec imports\n"
+          "  --watch         run again whenever the spec file or a file it\n"
+          "                  reads changes\n",
+          prog);
+  exit(1);
+}
+
+/// Looks up a non-terminal by name, with or without the leading $
+static int find_non_terminal(NonTerminalPtr nontermTable, int nontermTableSize,
+                             char *name) {
+  for (int i=0 ; i<nontermTableSize ; i++) {
+    char *nontermName = nontermTable[i].name;
+
+    if (strcmp(nontermName, name) == 0 || strcmp(nontermName+1, name) == 0) {
+      return i;
+    }
+  }
+
+  fprintf(stderr, "Error: unknown non-terminal %s\n", name);
+  exit(1);
+}
+
+static bool has_decoder(NonTerminalPtr nontermTable, int nontermTableSize,
+                        DecoderType decoder) {
+  for (int i=0 ; i<nontermTableSize ; i++) {
+    if (nontermTable[i].decoder == decoder) {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+/// Validates every line of a file against a non-terminal and prints the
+/// lines that don't match
+static int validate_lines(int nontermIdx, char *path,
+                          NFAStatePtr nfaStateTable, NFAEdgePtr nfaEdgeTable,
+                          NFAPtr nfaTable) {
+  char *buf;
+  long size;
+
+  if (!read_file_pread(path, &buf, &size)) {
+    return 1;
+  }
+
+  long numLines = 0;
+
+  for (long i=0 ; i<size ; i++) {
+    numLines += buf[i] == '\n';
+  }
+
+  // the last line might not end with a new line
+  numLines++;
+  const char **lines = malloc(numLines*sizeof(char*));
+  int *lens = malloc(numLines*sizeof(int));
+  uint64_t *matches = malloc(((numLines + 63) / 64)*sizeof(uint64_t));
+  assert(lines != NULL && lens != NULL && matches != NULL
+         && "Out of memory!\n");
+  numLines = 0;
+
+  for (long start=0, end=0 ; start<size ; start=end+1) {
+    end = start;
+
+    while (end < size && buf[end] != '\n') {
+      end++;
+    }
+
+    lines[numLines] = buf + start;
+    lens[numLines++] = end - start;
+  }
+
+  Validator validator;
+  init_validator(&validator, nontermIdx, nfaStateTable, nfaEdgeTable,
+                 nfaTable);
+  validate_strings(&validator, lines, lens, numLines, matches);
+
+  long numValid = 0;
+
+  for (long i=0 ; i<numLines ; i++) {
+    if (matches[i / 64] >> (i % 64) & 1) {
+      numValid++;
+    } else {
+      printf("%.*s\n", lens[i], lines[i]);
+    }
+  }
+
+  fprintf(stderr, "%ld of %ld lines match\n", numValid, numLines);
+  free_validator(&validator);
+  free(lines);
+  free(lens);
+  free(matches);
+  free(buf);
+  return 0;
+}
+
+/// Prints a binary token file block by block
+static int dump_tokens(ScannerPtr scanner, char *path) {
+  TokenFile file;
+  Token tokens[TOKEN_FILE_BLOCK_SIZE];
+
+  if (!open_token_file(path, &file)) {
+    return 1;
+  }
+
+  if (file.header->specHash != scanner->specHash) {
+    fprintf(stderr, "Warning: %s was produced with a different spec\n", path);
+  }
+
+  for (uint64_t i=0 ; i<file.header->numBlocks ; i++) {
+    int numTokens = read_token_block(&file, i, tokens);
+    bool valid = numTokens != -1;
+
+    for (int t=0 ; valid && t<numTokens ; t++) {
+      valid = tokens[t].kind >= NO_TOKEN
+        && tokens[t].kind < scanner->nontermTableSize;
+    }
+
+    if (!valid) {
+      fprintf(stderr, "Error: block %llu of %s is corrupt\n",
+              (unsigned long long)i, path);
+      close_token_file(&file);
+      return 1;
+    }
+
+    TokenBuffer block = { .tokens = tokens, .size = numTokens,
+                          .capacity = TOKEN_FILE_BLOCK_SIZE };
+    write_tokens_text(stdout, scanner, &block);
+  }
+
+  close_token_file(&file);
+  return 0;
+}
+
+static double now_seconds() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static bool same_file_version(struct stat *s1, struct stat *s2) {
+  return s1->st_ino == s2->st_ino && s1->st_size == s2->st_size
+    && s1->st_mtim.tv_sec == s2->st_mtim.tv_sec
+    && s1->st_mtim.tv_nsec == s2->st_mtim.tv_nsec;
+}
+
+/// Writes the files the spec read to watchPipe when a child of watch_spec
+/// exits, even if it fails, e.g. on an error in an imported module
+static void report_spec_files() {
+  const char *paths[MAX_SPEC_FILES];
+  int numPaths = get_spec_files(paths);
+
+  for (int i=0 ; i<numPaths ; i++) {
+    if (write(watchPipe, paths[i], strlen(paths[i]) + 1) < 0) {
+      break;
+    }
+  }
+
+  close(watchPipe);
+}
+
+/// Reads the paths a child reported until it exits, and starts watching
+/// the ones not watched yet. A file is never dropped from the watch, a
+/// run that fails early may not have read it.
+static void add_watched_files(int in, WatchedFilePtr files, int *numFiles) {
+  static char buf[MAX_SPEC_FILES * MAX_REGEX_LEN];
+  long size = 0;
+  ssize_t n;
+
+  while (size < (long)sizeof(buf)
+         && (n = read(in, buf + size, sizeof(buf) - size)) > 0) {
+    size += n;
+  }
+
+  for (char *path=buf ; path<buf+size ; path+=strlen(path)+1) {
+    if (memchr(path, '\0', buf + size - path) == NULL) {
+      break;
+    }
+
+    bool known = FALSE;
+
+    for (int i=0 ; i<*numFiles && !known ; i++) {
+      known = strcmp(files[i].path, path) == 0;
+    }
+
+    if (!known && *numFiles < MAX_WATCHED_FILES
+        && strlen(path) < MAX_REGEX_LEN) {
+      WatchedFilePtr file = files + (*numFiles)++;
+      strcpy(file->path, path);
+
+      // the version the child read, as far as the watch can tell
+      if (stat(path, &file->last) != 0) {
+        memset(&file->last, 0, sizeof(struct stat));
+      }
+    }
+  }
+}
+
+/// Runs the rest of main in a child process whenever the spec or one of
+/// the files it reads (see get_spec_files) changes, forever. Only returns
+/// in the children. Every run starts from empty pools, which is what
+/// recompiling in the same process would have to restore, and a run
+/// ending with an error doesn't end the watch. Use --build-cache to only
+/// rebuild what changed.
+static void watch_spec(char *specPath) {
+  struct timespec interval = { 0, WATCH_INTERVAL_NS };
+  static WatchedFile files[MAX_WATCHED_FILES];
+  int numFiles = 1;
+  snprintf(files[0].path, MAX_REGEX_LEN, "%s", specPath);
+  memset(&files[0].last, 0, sizeof(struct stat));
+
+  while (TRUE) {
+    struct stat current[MAX_WATCHED_FILES];
+    bool changed = FALSE;
+
+    // an editor may replace a file, which is missing for a moment
+    for (int i=0 ; i<numFiles ; i++) {
+      if (stat(files[i].path, current + i) != 0) {
+        current[i] = files[i].last;
+      }
+
+      changed |= !same_file_version(current + i, &files[i].last);
+    }
+
+    if (!changed) {
+      nanosleep(&interval, NULL);
+      continue;
+    }
+
+    for (int i=0 ; i<numFiles ; i++) {
+      files[i].last = current[i];
+    }
+
+    double start = now_seconds();
+    int fds[2];
+    fflush(stdout);
+
+    if (pipe(fds) != 0) {
+      fprintf(stderr, "Error: cannot run the compiler again\n");
+      exit(1);
+    }
+
+    pid_t pid = fork();
+
+    if (pid == 0) {
+      close(fds[0]);
+      watchPipe = fds[1];
+      atexit(report_spec_files);
+      return;
+    }
+
+    close(fds[1]);
+
+    if (pid > 0) {
+      add_watched_files(fds[0], files, &numFiles);
+    }
+
+    close(fds[0]);
+    int status = 1;
+
+    if (pid < 0 || waitpid(pid, &status, 0) < 0) {
+      fprintf(stderr, "Error: cannot run the compiler again\n");
+      exit(1);
+    }
+
+    fprintf(stderr, "%s %s in %.3f s, watching for changes\n",
+            WIFEXITED(status) && WEXITSTATUS(status) == 0 ? "Compiled"
+            : "Failed to compile", specPath, now_seconds() - start);
+  }
+}
+
+static int emit_scanner(ScannerPtr scanner, char *path) {
+  FILE *out = fopen(path, "w");
+
+  if (out == NULL) {
+    fprintf(stderr, "Error: cannot write %s\n", path);
+    return 1;
+  }
+
+  emit_c_scanner(out, scanner);
+  fclose(out);
+  return 0;
+}
 
 int main(int argc, char** argv) {
   NonTerminalPtr nontermTable = NULL;
   ExpressionPtr exprTable = NULL;
   char *termTable = NULL;
+  NFAStatePtr nfaStateTable = NULL;
+  NFAEdgePtr nfaEdgeTable = NULL;
+  NFAPtr nfaTable = NULL;
+  char *specPath = NULL;
+  char *batchList = NULL;
+  char *dumpPath = NULL;
+  char *searchName = NULL;
+  char *validateName = NULL;
+  char *validatePath = NULL;
+  char *symbolsPath = NULL;
+  char *emitPath = NULL;
+  char *buildCache = NULL;
+  bool watch = FALSE;
+  uint64_t fingerprints[MAX_NONTERMS];
+  BatchOptions batchOptions;
+  SymbolTable symbols;
+  Pipeline pipeline;
+
+  init_batch_options(&batchOptions);
+  init_default_pipeline(&pipeline);
+
+  for (int i=1 ; i<argc ; i++) {
+    bool hasValue = i+1 < argc;
+
+    if (strcmp(argv[i], "--spec") == 0 && hasValue) {
+      specPath = argv[++i];
+    } else if (strcmp(argv[i], "--batch") == 0 && hasValue) {
+      batchList = argv[++i];
+    } else if (strcmp(argv[i], "--jobs") == 0 && hasValue) {
+      batchOptions.numThreads = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--out-dir") == 0 && hasValue) {
+      batchOptions.outDir = argv[++i];
+    } else if (strcmp(argv[i], "--chunk-size") == 0 && hasValue) {
+      batchOptions.chunkSize = atol(argv[++i]);
+    } else if (strcmp(argv[i], "--cache") == 0 && hasValue) {
+      batchOptions.cacheDir = argv[++i];
+    } else if (strcmp(argv[i], "--format") == 0 && hasValue) {
+      i++;
+
+      if (strcmp(argv[i], "binary") == 0) {
+        batchOptions.format = BINARY_TOKENS;
+      } else if (strcmp(argv[i], "text") == 0) {
+        batchOptions.format = TEXT_TOKENS;
+      } else {
+        usage(argv[0]);
+      }
+    } else if (strcmp(argv[i], "--dump-tokens") == 0 && hasValue) {
+      dumpPath = argv[++i];
+    } else if (strcmp(argv[i], "--emit-c") == 0 && hasValue) {
+      emitPath = argv[++i];
+    } else if (strcmp(argv[i], "--symbols") == 0 && hasValue) {
+      symbolsPath = argv[++i];
+    } else if (strcmp(argv[i], "--search") == 0 && hasValue) {
+      searchName = argv[++i];
+    } else if (strcmp(argv[i], "--validate") == 0 && i+2 < argc) {
+      validateName = argv[++i];
+      validatePath = argv[++i];
+    } else if (strcmp(argv[i], "--passes") == 0 && hasValue) {
+      if (!parse_pipeline(&pipeline, argv[++i])) {
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--list-passes") == 0) {
+      print_passes(stdout);
+      return 0;
+    } else if (strcmp(argv[i], "--pass-stats") == 0) {
+      pipeline.printStats = TRUE;
+    } else if (strcmp(argv[i], "--build-cache") == 0 && hasValue) {
+      buildCache = argv[++i];
+    } else if (strcmp(argv[i], "--watch") == 0) {
+      watch = TRUE;
+    } else if (strcmp(argv[i], "--count") == 0) {
+      batchOptions.countOnly = TRUE;
+    } else if (strcmp(argv[i], "--tags") == 0) {
+      batchOptions.captureTags = TRUE;
+    } else if (strcmp(argv[i], "--values") == 0) {
+      batchOptions.decodeValues = TRUE;
+    } else if (strcmp(argv[i], "--no-uring") == 0) {
+      batchOptions.useUring = FALSE;
+    } else {
+      usage(argv[0]);
+    }
+  }
+
+  if ((batchOptions.captureTags || batchOptions.decodeValues)
+      && (batchOptions.format == BINARY_TOKENS || batchOptions.countOnly
+          || searchName != NULL)) {
+    fprintf(stderr, "Error: --tags and --values only work when writing "
+            "text tokens\n");
+    return 1;
+  }
+
+  if (watch && specPath == NULL) {
+    fprintf(stderr, "Error: --watch needs a --spec file\n");
+    return 1;
+  }
+
+  if (watch) {
+    watch_spec(specPath);
+  }
+
+  FILE *spec = stdin;
 
-  int nontermTableSize = parse_regex_spec(stdin, &nontermTable,
+  if (specPath != NULL && (spec = fopen(specPath, "r")) == NULL) {
+    fprintf(stderr, "Error: cannot open spec %s\n", specPath);
+    return 1;
+  }
+
+  if (buildCache != NULL) {
+    set_module_cache(buildCache, pipeline_fingerprint(&pipeline));
+  }
+
+  int nontermTableSize = parse_regex_spec(spec, &nontermTable,
                                           &exprTable, &termTable);
-  build_nfa(nontermTable, nontermTableSize, exprTable, termTable);
+  run_passes(&pipeline, AST_PASS);
 
-  return 0;
+  if (buildCache != NULL) {
+    fingerprint_non_terminals(fingerprints);
+    set_nfa_cache(buildCache, fingerprints);
+  }
+
+  PoolOffset nfaIdx = build_nfa(nontermTable, nontermTableSize, exprTable,
+                                termTable, &nfaStateTable, &nfaEdgeTable,
+                                &nfaTable);
+
+  // after build_nfa stored the NFAs the modules' artifacts refer to
+  if (buildCache != NULL) {
+    save_module_artifacts(fingerprints);
+  }
+
+  run_passes(&pipeline, NFA_PASS);
+
+  if (validateName != NULL) {
+    int nontermIdx = find_non_terminal(nontermTable, nontermTableSize,
+                                       validateName);
+    return validate_lines(nontermIdx, validatePath, nfaStateTable,
+                          nfaEdgeTable, nfaTable);
+  }
+
+  if (batchList == NULL && dumpPath == NULL && emitPath == NULL) {
+    print_nfa_graphviz(nfaIdx);
+    return 0;
+  }
+
+  DFAStatePtr dfaStateTable = NULL;
+  DFAPtr dfaTable = NULL;
+  ModePtr modeTable = NULL;
+  int numModes = get_modes(&modeTable);
+  PoolOffset dfaIdx = -1;
+
+  for (int m=0 ; m<numModes ; m++) {
+    PoolOffset modeDFAIdx;
+
+    if (buildCache != NULL) {
+      uint64_t key = mode_fingerprint(m, nontermTable, nontermTableSize,
+                                      fingerprints, &pipeline);
+      modeDFAIdx = build_cached_dfa(nfaStateTable, nfaEdgeTable, nfaTable,
+                                    get_mode_nfa(m), &dfaStateTable,
+                                    &dfaTable, buildCache, key);
+    } else {
+      modeDFAIdx = build_dfa(nfaStateTable, nfaEdgeTable, nfaTable,
+                             get_mode_nfa(m), &dfaStateTable, &dfaTable);
+    }
+
+    // the modes' DFAs are consecutive, starting with the initial mode's
+    if (m == INITIAL_MODE) {
+      dfaIdx = modeDFAIdx;
+    }
+  }
+
+  Scanner scanner;
+  init_scanner(&scanner, dfaStateTable, dfaTable + dfaIdx, numModes,
+               nontermTable, nontermTableSize);
+
+  if (dumpPath != NULL) {
+    return dump_tokens(&scanner, dumpPath);
+  }
+
+  if (emitPath != NULL) {
+    return emit_scanner(&scanner, emitPath);
+  }
+
+  Searcher searcher;
+
+  if (searchName != NULL) {
+    int nontermIdx = find_non_terminal(nontermTable, nontermTableSize,
+                                       searchName);
+    init_searcher(&searcher, &scanner, nontermIdx, exprTable, termTable,
+                  nfaStateTable, nfaEdgeTable, nfaTable);
+    batchOptions.searcher = &searcher;
+  }
+
+  if (batchOptions.decodeValues
+      && has_decoder(nontermTable, nontermTableSize, INTERN_DECODER)) {
+    // ids depend on the order the workers meet the symbols in
+    if (batchOptions.cacheDir != NULL) {
+      fprintf(stderr, "Error: the symbol ids of [intern] rules can't be "
+              "cached\n");
+      return 1;
+    }
+
+    init_symbol_table(&symbols, DEFAULT_SYMBOL_CAPACITY);
+    batchOptions.symbols = &symbols;
+  }
+
+  int numPaths = 0;
+  char **paths = read_path_list(batchList, &numPaths);
+  BatchStats stats;
+  int numFailed = lex_batch(&scanner, paths, numPaths, &batchOptions, &stats);
+
+  fprintf(stderr, "Scanned %ld files (%ld bytes, %ld tokens, %ld unmatched, "
+          "%ld cached) in %.3f s using %d threads: %.1f MB/s\n",
+          stats.numFiles, stats.numBytes, stats.numTokens, stats.numUnmatched,
+          stats.numCacheHits, stats.seconds, batchOptions.numThreads,
+          stats.numBytes / (stats.seconds > 0 ? stats.seconds : 1) / 1e6);
+
+  if (batchOptions.countOnly) {
+    for (int k=0 ; k<nontermTableSize ; k++) {
+      if (searchName == NULL || k == searcher.nontermIdx) {
+        printf("%s %ld\n", nontermTable[k].name, stats.kindCounts[k+1]);
+      }
+    }
+
+    if (searchName == NULL) {
+      printf("<unmatched> %ld\n", stats.kindCounts[0]);
+    }
+  }
+
+  if (batchOptions.symbols != NULL && symbolsPath != NULL) {
+    FILE *out = fopen(symbolsPath, "w");
+
+    if (out == NULL) {
+      fprintf(stderr, "Error: cannot write %s\n", symbolsPath);
+      return 1;
+    }
+
+    write_symbols(out, &symbols);
+    fclose(out);
+  }
+
+  return numFailed == 0 ? 0 : 1;
 }
@@ -1,61 +1,26 @@
 #include "../include/nfa.h"
+#include "../include/product.h"
+#include "../include/dictionary.h"
+#include "../include/artifacts.h"
 
 /// This is an implementation of Thompson's Construction to obtain NFAs
 /// from regexs. For more details check "Engineering a Compiler", 2011,
 /// Section 2.4.2
 
-// Since for each regex (or a combination of 2 regexs), we need a constant
-// number of new epsilon transitions (specifically, 1 for concatination
-// , 4 for or, and 4 for Closure), the maximum total number in the final
-// NFA will be c * (MAX_NESTED_EXPRS + MAX_NONTERMS) for some constant
-// c < 5 (see regex.h for a definition of MAX_NESTED_EXPRS and MAX_NONTERMS).
-// I use a constant factor of 10 here because in regex spec a reserved
-// word is represented as a single unit while in the NFAs, reserved words
-// are split to their individual characters. This gives an average of 6
-// characters per reserved word, assuming that all terminals were reserved
-// words which is too generous and more than enough.
-#define MAX_NFA_EDGES      10 * (MAX_NESTED_EXPRS + MAX_NONTERMS)
-#define MAX_EDGES_PER_NODE 128
-#define MAX_NFA_STATES     1024
-#define MAX_NFAS           MAX_NFA_STATES / 4
-#define EPSILON            0
-#define DEBUG              1
-
-struct NFAEdge;
-
-typedef enum {
-  START,
-  INTERNAL,
-  ACCEPTING
-} NFAStateType;
-
-typedef struct NFAState {
-  PoolOffset edges[MAX_EDGES_PER_NODE];
-  int numEdges;
-  NFAStateType type;
-#if DEBUG
-  bool visited;
-#endif
-} NFAState, *NFAStatePtr;
-
-typedef struct NFAEdge {
-  PoolOffset target;
-  char symbol;
-} NFAEdge, *NFAEdgePtr;
-
-typedef struct NFA {
-  PoolOffset start;
-  PoolOffset accepting[MAX_EDGES_PER_NODE];
-  int numAccepting; 
-} NFA, *NFAPtr;
-
-static NFAState nfaStatesPool[MAX_NFA_STATES];
+/// The pools are allocated on demand and grow as needed (see
+/// grow_capacity), which moves them. Hence, a pointer into the states or
+/// NFAs pool is only valid until the next state or NFA is added, and one
+/// into the edges pool until the next edge is.
+static NFAStatePtr nfaStatesPool = NULL;
+static int maxNFAStates = 0;
 static PoolOffset currentNFAState = 0;
 
-static NFAEdge nfaEdgePool[MAX_NFA_EDGES];
+static NFAEdgePtr nfaEdgePool = NULL;
+static int maxNFAEdges = 0;
 static PoolOffset currentNFAEdge = 0;
 
-static NFA nfaPool[MAX_NFAS];
+static NFAPtr nfaPool = NULL;
+static int maxNFAs = 0;
 static PoolOffset currentNFA = 0;
 
 static NonTerminalPtr nontermTable;
@@ -65,32 +30,102 @@ static char *termTable;
 
 // Maps a non-termianl index to the index of its corresponding NFA or -1
 // if the NFA is not yet created
-static PoolOffset nontermToNFAMap[MAX_NFAS];
+static PoolOffset nontermToNFAMap[MAX_NONTERMS];
+
+// Maps a non-terminal index to its top-level NFA, i.e. the one built for
+// the non-terminal itself rather than a copy embedded in another NFA.
+// Every reference to a non-terminal builds a fresh copy which overwrites
+// nontermToNFAMap, hence the top-level ones are kept separately.
+static PoolOffset nontermToTokenNFAMap[MAX_NONTERMS];
+
+// Maps a mode to the NFA combining the non-terminals active in it
+static PoolOffset modeToNFAMap[MAX_MODES];
+
+// see set_nfa_cache
+static const char *nfaCacheDir = NULL;
+static uint64_t *nfaFingerprints;
+
+// The arrays indexed by state grow along with the states pool, see
+// grow_states_pool.
+//
+// The walks of the NFA passes mark the states they reach with the
+// current walk's number rather than clearing a flag per state every time
+static int *reachedStates = NULL;
+static int currentWalk = 0;
+static PoolOffset *walkStack = NULL;
+// the states bypass_epsilon_states must keep, see there
+static bool *keptStates = NULL;
+// build_reverse_nfa's copy of every state, and the state the copy's next
+// edge goes to, which differs once the copy overflows (see append_edge)
+static PoolOffset *reverseStates = NULL;
+static PoolOffset *reverseTails = NULL;
+
+// build_code_point_nfa's trie of UTF-8 sequences. Node 0 is the root and
+// UTF8_LEAF stands for the end of a sequence. The edges of a node form a
+// list in the order they were added.
+#define MAX_UTF8_NODES   16384
+#define UTF8_LEAF        -2
+#define UTF8_HASH_SIZE   (2 * MAX_UTF8_NODES)
+static int utf8NodeFirstEdge[MAX_UTF8_NODES];
+static int utf8NodeLastEdge[MAX_UTF8_NODES];
+static int numUtf8Nodes;
+static int utf8EdgeNext[MAX_UTF8_NODES];
+static unsigned char utf8EdgeFirst[MAX_UTF8_NODES];
+static unsigned char utf8EdgeLast[MAX_UTF8_NODES];
+static int utf8EdgeChild[MAX_UTF8_NODES];
+static int numUtf8Edges;
+// the node every node is merged into and the NFA state built for it
+static int utf8NodeCanon[MAX_UTF8_NODES];
+static PoolOffset utf8NodeState[MAX_UTF8_NODES];
+static int utf8NodeHashTable[UTF8_HASH_SIZE];
 
 static PoolOffset new_start_state();
 static PoolOffset new_state(NFAStateType type);
 static PoolOffset new_accepting_state();
 static PoolOffset new_edge(PoolOffset target, char symbol);
+static PoolOffset new_range_edge(PoolOffset target, char first, char last);
 static PoolOffset new_nfa();
+static void grow_states_pool();
+static void grow_edges_pool();
+static void grow_nfas_pool();
 static PoolOffset build_single_symbol_nfa(char symbol);
 static void build_concat_nfa(PoolOffset nfa1Idx, PoolOffset nfa2Idx);
 static void build_or_nfa(PoolOffset nfa1Idx, PoolOffset nfa2Idx);
 static void build_closure_nfa(PoolOffset nfaIdx);
-
-static PoolOffset build_terminal_nfa(char *termianl);
+static void build_plus_nfa(PoolOffset nfaIdx);
+static void build_intersect_nfa(PoolOffset nfa1Idx, PoolOffset nfa2Idx);
+static void build_complement_nfa(PoolOffset nfaIdx);
+static void replace_with_product_nfa(PoolOffset nfaIdx, PoolOffset dfaIdx);
+
+static PoolOffset build_terminal_nfa(char *termianl, bool caseless);
+static PoolOffset build_tag_nfa(int tag);
+static PoolOffset build_code_point_nfa(PoolOffset setIdx);
+static PoolOffset build_dictionary_nfa(PoolOffset dictIdx);
+static void add_utf8_sequence(Utf8SequencePtr sequence);
+static int add_utf8_edge(int nodeIdx, unsigned char first, unsigned char last,
+                         int childIdx);
+static void merge_utf8_node(int nodeIdx);
+static bool same_utf8_edges(int node1Idx, int node2Idx);
+static void append_edge(PoolOffset *stateIdx, PoolOffset edgeIdx);
 static PoolOffset build_regex_expr_nfa(PoolOffset exprIdx);
 static PoolOffset build_non_terminal_nfa(PoolOffset nontermIdx);
+static PoolOffset load_cached_nfa(uint64_t key);
+static void save_non_terminal_nfa(int nontermIdx, PoolOffset firstState,
+                                  PoolOffset firstEdge);
 
-static void print_nfa_graphviz(PoolOffset nfaIdx);
 static void update_state_type(PoolOffset stateIdx, NFAStateType newType);
+static bool reaches(PoolOffset fromIdx, PoolOffset toIdx);
+static int mark_reachable(PoolOffset stateIdx, int *numEdges);
 
 #if DEBUG
 static void print_nfa(PoolOffset nfaIdx);
 static void print_state(PoolOffset stateIdx);
 #endif
 
-void build_nfa(NonTerminalPtr _nontermTable, int _nontermTableSize,
-               ExpressionPtr _exprTable, char *_termTable) {
+PoolOffset build_nfa(NonTerminalPtr _nontermTable, int _nontermTableSize,
+                     ExpressionPtr _exprTable, char *_termTable,
+                     NFAStatePtr *nfaStateTable, NFAEdgePtr *nfaEdgeTable,
+                     NFAPtr *nfaTable) {
   nontermTable = _nontermTable;
   nontermTableSize = _nontermTableSize;
   exprTable = _exprTable;
@@ -99,10 +134,28 @@ void build_nfa(NonTerminalPtr _nontermTable, int _nontermTableSize,
   // -1 is all 1's in binary rep, hence setting every byte of a 4-byte
   // word to -1 is the same as setting the entire word to -1. Hence, use
   // memset instead of looping.
-  memset(nontermToNFAMap, -1, MAX_NFAS*sizeof(PoolOffset));
+  memset(nontermToNFAMap, -1, MAX_NONTERMS*sizeof(PoolOffset));
 
   for (int i=0 ; i<nontermTableSize ; i++) {
-    build_non_terminal_nfa(i);
+    PoolOffset firstState = currentNFAState;
+    PoolOffset firstEdge = currentNFAEdge;
+
+    nontermToTokenNFAMap[i] = nfaCacheDir == NULL ? -1
+      : load_cached_nfa(nfaFingerprints[i]);
+
+    if (nontermToTokenNFAMap[i] == -1) {
+      nontermToTokenNFAMap[i] = build_non_terminal_nfa(i);
+
+      if (nfaCacheDir != NULL) {
+        save_non_terminal_nfa(i, firstState, firstEdge);
+      }
+    }
+
+    // a non-terminal's NFA, including the copies of the non-terminals it
+    // refers to, occupies a contiguous range of the states pool
+    for (PoolOffset s=firstState ; s<currentNFAState ; s++) {
+      nfaStatesPool[s].owner = i;
+    }
   }
 
   /* for (int i=1 ; i<nontermTableSize ; i++) { */
@@ -111,29 +164,232 @@ void build_nfa(NonTerminalPtr _nontermTable, int _nontermTableSize,
 
   /* print_nfa_graphviz(nontermToNFAMap[2]); */
 
-  PoolOffset globalStartIdx = new_start_state();
-  NFAStatePtr globalStart = nfaStatesPool + globalStartIdx;
-  PoolOffset globalNFAIdx = new_nfa();
-  NFAPtr globalNFA = nfaPool + globalNFAIdx;
-  globalNFA->start = globalStartIdx;
+  int numModes = get_modes(NULL);
+  assert(nontermTableSize < MAX_EDGES_PER_NODE && "Too many non-terminals"
+         " to combine!\n");
+
+  for (int m=0 ; m<numModes ; m++) {
+    PoolOffset globalStartIdx = new_start_state();
+    PoolOffset globalNFAIdx = new_nfa();
+    NFAStatePtr globalStart = nfaStatesPool + globalStartIdx;
+    NFAPtr globalNFA = nfaPool + globalNFAIdx;
+    globalNFA->start = globalStartIdx;
+
+    for (int i=0 ; i<nontermTableSize ; i++) {
+      // the rules of other modes don't accept in this mode's NFA
+      if (nontermTable[i].mode != m) {
+        globalNFA->accepting[i] = NO_STATE;
+        continue;
+      }
+
+      PoolOffset nfaIdx = nontermToTokenNFAMap[i];
+      PoolOffset nfaStartIdx = nfaPool[nfaIdx].start;
+      NFAStatePtr nfaStart = nfaStatesPool + nfaStartIdx;
+      nfaStart->type = INTERNAL;
+      globalStart->edges[globalStart->numEdges] =
+        new_edge(nfaStartIdx, EPSILON);
+      ++(globalStart->numEdges);
+      globalNFA->accepting[i] = nfaPool[nfaIdx].accepting[0];
+    }
+
+    globalNFA->numAccepting = nontermTableSize;
+    modeToNFAMap[m] = globalNFAIdx;
+  }
+
+  if (nfaStateTable != NULL) {
+    *nfaStateTable = nfaStatesPool;
+    *nfaEdgeTable = nfaEdgePool;
+    *nfaTable = nfaPool;
+  }
+
+  return modeToNFAMap[INITIAL_MODE];
+}
+
+void set_nfa_cache(const char *dir, uint64_t *fingerprints) {
+  nfaCacheDir = dir;
+  nfaFingerprints = fingerprints;
+}
+
+void get_nfa_tables(NFAStatePtr *states, NFAEdgePtr *edges, NFAPtr *nfas) {
+  *states = nfaStatesPool;
+  *edges = nfaEdgePool;
+  *nfas = nfaPool;
+}
+
+int get_num_nfa_states() {
+  return currentNFAState;
+}
+
+PoolOffset get_mode_nfa(int mode) {
+  assert(mode < get_modes(NULL) && "Invalid mode!\n");
+  return modeToNFAMap[mode];
+}
+
+PoolOffset get_non_terminal_nfa(int nontermIdx) {
+  assert(nontermIdx < nontermTableSize && "Invalid non-terminal!\n");
+  return nontermToTokenNFAMap[nontermIdx];
+}
+
+PoolOffset build_reverse_nfa(PoolOffset nfaIdx, int maxStates) {
+  NFA nfa = nfaPool[nfaIdx];
+  assert(nfa.numAccepting == 1 && "Invalid NFAs");
+  currentWalk++;
+  reachedStates[nfa.start] = currentWalk;
+  walkStack[0] = nfa.start;
+  int numStates = 1;
+
+  // unlike mark_reachable, the walk uses walkStack as a queue, which
+  // leaves every reachable state in it
+  for (int i=0 ; i<numStates ; i++) {
+    NFAStatePtr state = nfaStatesPool + walkStack[i];
+
+    for (int e=0 ; e<state->numEdges ; e++) {
+      PoolOffset target = nfaEdgePool[state->edges[e]].target;
+
+      if (reachedStates[target] == currentWalk) {
+        continue;
+      }
+
+      if (numStates == maxStates) {
+        return -1;
+      }
+
+      reachedStates[target] = currentWalk;
+      walkStack[numStates++] = target;
+    }
+  }
+
+  // new states move the arrays indexed by state, hence, their entries
+  // are only read and written around the calls adding them
+  for (int i=0 ; i<numStates ; i++) {
+    PoolOffset copyIdx = new_state(INTERNAL);
+    reverseStates[walkStack[i]] = copyIdx;
+    reverseTails[walkStack[i]] = copyIdx;
+  }
+
+  for (int i=0 ; i<numStates ; i++) {
+    PoolOffset s = walkStack[i];
+
+    for (int e=0 ; e<nfaStatesPool[s].numEdges ; e++) {
+      NFAEdge edge = nfaEdgePool[nfaStatesPool[s].edges[e]];
+      PoolOffset tailIdx = reverseTails[edge.target];
+      append_edge(&tailIdx, new_range_edge(reverseStates[s], edge.symbol,
+                                           edge.last));
+      reverseTails[edge.target] = tailIdx;
+    }
+  }
+
+  PoolOffset reverseIdx = new_nfa();
+  NFA reverse = nfaPool[reverseIdx];
+  NFAStatePtr start = nfaStatesPool + reverse.start;
+  start->edges[start->numEdges++] = new_range_edge(reverse.start,
+                                                   EPSILON + 1, (char)0xff);
+
+  // a rule matching nothing, e.g. an & of disjoint non-terminals
+  if (reachedStates[nfa.accepting[0]] == currentWalk) {
+    start->edges[start->numEdges++] =
+      new_edge(reverseStates[nfa.accepting[0]], EPSILON);
+  }
+
+  PoolOffset tailIdx = reverseTails[nfa.start];
+  append_edge(&tailIdx, new_edge(reverse.accepting[0], EPSILON));
+  return reverseIdx;
+}
+
+int remove_dead_rules() {
+  int numRemoved = 0;
+
+  for (int m=0 ; m<get_modes(NULL) ; m++) {
+    NFAPtr globalNFA = nfaPool + modeToNFAMap[m];
+    NFAStatePtr globalStart = nfaStatesPool + globalNFA->start;
+
+    for (int i=0 ; i<nontermTableSize ; i++) {
+      NFAPtr nfa = nfaPool + nontermToTokenNFAMap[i];
+
+      if (globalNFA->accepting[i] == NO_STATE
+          || reaches(nfa->start, nfa->accepting[0])) {
+        continue;
+      }
+
+      int numKept = 0;
+
+      for (int e=0 ; e<globalStart->numEdges ; e++) {
+        if (nfaEdgePool[globalStart->edges[e]].target != nfa->start) {
+          globalStart->edges[numKept++] = globalStart->edges[e];
+        }
+      }
+
+      globalStart->numEdges = numKept;
+      globalNFA->accepting[i] = NO_STATE;
+      numRemoved++;
+    }
+  }
+
+  return numRemoved;
+}
+
+int bypass_epsilon_states() {
+  memset(keptStates, 0, currentNFAState*sizeof(bool));
+
+  // where a token ends must stay a state of its own, so do the states
+  // telling build_dfa which decoder a token needs
+  for (int m=0 ; m<get_modes(NULL) ; m++) {
+    NFAPtr globalNFA = nfaPool + modeToNFAMap[m];
+
+    for (int i=0 ; i<globalNFA->numAccepting ; i++) {
+      if (globalNFA->accepting[i] != NO_STATE) {
+        keptStates[globalNFA->accepting[i]] = TRUE;
+      }
+    }
+  }
 
   for (int i=0 ; i<nontermTableSize ; i++) {
-    PoolOffset nfaIdx = nontermToNFAMap[i];
-    PoolOffset nfaStartIdx = nfaPool[nfaIdx].start;
-    PoolOffset nfaAcceptingIdx = nfaPool[nfaIdx].accepting[0];
-    NFAStatePtr nfaStart = nfaStatesPool + nfaStartIdx;
-    nfaStart->type = INTERNAL;
-    globalStart->edges[globalStart->numEdges] =
-      new_edge(nfaStartIdx, EPSILON);
-    ++(globalStart->numEdges);
-    globalNFA->accepting[globalNFA->numAccepting-1] = nfaAcceptingIdx;
-    globalNFA->numAccepting++;
-    assert(globalNFA->numAccepting < MAX_EDGES_PER_NODE
-           && "Exhausted available memory");
+    keptStates[nfaPool[nontermToTokenNFAMap[i]].accepting[0]] = TRUE;
   }
 
-  assert(globalNFA->numAccepting-1 == nontermTableSize && "BUG");
-  print_nfa_graphviz(globalNFAIdx);
+  for (PoolOffset s=0 ; s<currentNFAState ; s++) {
+    NFAStatePtr state = nfaStatesPool + s;
+
+    if (state->decoder != NO_DECODER || state->numEdges != 1) {
+      keptStates[s] = TRUE;
+      continue;
+    }
+
+    NFAEdgePtr edge = nfaEdgePool + state->edges[0];
+    keptStates[s] |= edge->symbol != EPSILON || edge->last != EPSILON
+      || edge->tag != NO_TAG;
+  }
+
+  int numRedirected = 0;
+
+  for (PoolOffset e=0 ; e<currentNFAEdge ; e++) {
+    PoolOffset target = nfaEdgePool[e].target;
+
+    // a cycle of bypassed states can't be left, the bound stops at it
+    for (int steps=0 ; !keptStates[target] && steps<currentNFAState ;
+         steps++) {
+      target = nfaEdgePool[nfaStatesPool[target].edges[0]].target;
+    }
+
+    if (target != nfaEdgePool[e].target) {
+      nfaEdgePool[e].target = target;
+      numRedirected++;
+    }
+  }
+
+  return numRedirected;
+}
+
+int count_nfa_states(int *numEdges) {
+  int numStates = 0;
+  *numEdges = 0;
+  currentWalk++;
+
+  for (int m=0 ; m<get_modes(NULL) ; m++) {
+    numStates += mark_reachable(nfaPool[modeToNFAMap[m]].start, numEdges);
+  }
+
+  return numStates;
 }
 
 /// Build the NFA for a single symbol in the alphabet
@@ -200,8 +456,8 @@ static void build_concat_nfa(PoolOffset nfa1Idx, PoolOffset nfa2Idx) {
 static void build_or_nfa(PoolOffset nfa1Idx, PoolOffset nfa2Idx) {
   assert(nfa1Idx != nfa2Idx && "Trying to OR an NFA to itself!\n");
   PoolOffset newStartIdx = new_start_state();
-  NFAStatePtr newStart = nfaStatesPool + newStartIdx;
   PoolOffset newAcceptingIdx = new_accepting_state();
+  NFAStatePtr newStart = nfaStatesPool + newStartIdx;
 
   NFAPtr nfa1 = nfaPool + nfa1Idx;
   NFAPtr nfa2 = nfaPool + nfa2Idx;
@@ -258,8 +514,8 @@ static void build_or_nfa(PoolOffset nfa1Idx, PoolOffset nfa2Idx) {
 ///                    eps
 static void build_closure_nfa(PoolOffset nfaIdx) {
   PoolOffset newStartIdx = new_start_state();
-  NFAStatePtr newStart = nfaStatesPool + newStartIdx;
   PoolOffset newAcceptingIdx = new_accepting_state();
+  NFAStatePtr newStart = nfaStatesPool + newStartIdx;
 
   NFAPtr nfa = nfaPool + nfaIdx;
   assert(nfa->numAccepting == 1 && "Invalid NFAs");
@@ -288,6 +544,117 @@ static void build_closure_nfa(PoolOffset nfaIdx) {
   nfa->accepting[0] = newAcceptingIdx;
 }
 
+/// Build the NFA for r+ for some regular expresion r expressed by the
+/// argument NFA. Unlike r*, the new accepting state can only be reached
+/// through r.
+///
+///                  INPUT
+///              ---  sym   ===
+///            >| a | ---> | b |
+///              ---        ===
+///
+///                  OUTPUT
+///                eps
+///            ------------
+///           |            |
+///           v            |
+///          ---  sym   ---  eps   ===
+///        >| a | ---> | b | ---> | c |
+///          ---        ---        ===
+static void build_plus_nfa(PoolOffset nfaIdx) {
+  PoolOffset newAcceptingIdx = new_accepting_state();
+
+  NFAPtr nfa = nfaPool + nfaIdx;
+  assert(nfa->numAccepting == 1 && "Invalid NFAs");
+  PoolOffset nfaAcceptingIdx = nfa->accepting[0];
+  NFAStatePtr nfaAccepting = nfaStatesPool + nfaAcceptingIdx;
+
+  update_state_type(nfaAcceptingIdx, INTERNAL);
+  nfaAccepting->edges[nfaAccepting->numEdges++] =
+    new_edge(nfa->start, EPSILON);
+  nfaAccepting->edges[nfaAccepting->numEdges++] =
+    new_edge(newAcceptingIdx, EPSILON);
+
+  nfa->accepting[0] = newAcceptingIdx;
+}
+
+/// Intersect nfa1 and nfa2 into nfa1 using the product of their DFAs, see
+/// product.h
+static void build_intersect_nfa(PoolOffset nfa1Idx, PoolOffset nfa2Idx) {
+  NFAPtr nfa1 = nfaPool + nfa1Idx;
+  NFAPtr nfa2 = nfaPool + nfa2Idx;
+  PoolOffset dfa1Idx = determinize_nfa(nfaStatesPool, nfaEdgePool,
+                                       nfa1->start, nfa1->accepting[0]);
+  PoolOffset dfa2Idx = determinize_nfa(nfaStatesPool, nfaEdgePool,
+                                       nfa2->start, nfa2->accepting[0]);
+  replace_with_product_nfa(nfa1Idx, intersect_dfas(dfa1Idx, dfa2Idx));
+  free_product_dfas();
+}
+
+/// Replaces the NFA with one accepting the strings it rejects
+static void build_complement_nfa(PoolOffset nfaIdx) {
+  NFAPtr nfa = nfaPool + nfaIdx;
+  PoolOffset dfaIdx = determinize_nfa(nfaStatesPool, nfaEdgePool,
+                                      nfa->start, nfa->accepting[0]);
+  replace_with_product_nfa(nfaIdx, complement_dfa(dfaIdx));
+  free_product_dfas();
+}
+
+/// Builds an NFA state per state of the product DFA and points the NFA at
+/// them. Transitions on consecutive bytes with the same target become a
+/// single range edge, and every accepting state gets an epsilon edge to a
+/// new accepting state, keeping the single accepting state the other
+/// constructions expect. The old states become unused storage.
+static void replace_with_product_nfa(PoolOffset nfaIdx, PoolOffset dfaIdx) {
+  ProductStatePtr productStates;
+  ProductDFAPtr productDFAs;
+  get_product_tables(&productStates, &productDFAs);
+  ProductDFA dfa = productDFAs[dfaIdx];
+
+  PoolOffset firstStateIdx = currentNFAState;
+
+  // the states are created before their edges, which may add overflow
+  // states (see append_edge)
+  for (int s=0 ; s<dfa.numStates ; s++) {
+    new_state(INTERNAL);
+  }
+
+  PoolOffset acceptingIdx = new_accepting_state();
+
+  for (int s=0 ; s<dfa.numStates ; s++) {
+    ProductStatePtr productState = productStates + dfa.start + s;
+    PoolOffset stateIdx = firstStateIdx + s;
+    int c = EPSILON + 1;
+
+    while (c < ALPHABET_SIZE) {
+      PoolOffset target = productState->transitions[c];
+      int last = c;
+
+      while (last + 1 < ALPHABET_SIZE
+             && productState->transitions[last+1] == target) {
+        last++;
+      }
+
+      if (target != DEAD_STATE) {
+        append_edge(&stateIdx, new_range_edge(firstStateIdx + target
+                                              - dfa.start, (char)c,
+                                              (char)last));
+      }
+
+      c = last + 1;
+    }
+
+    if (productState->accepting) {
+      append_edge(&stateIdx, new_edge(acceptingIdx, EPSILON));
+    }
+  }
+
+  // the product DFA's start state is its first one
+  update_state_type(firstStateIdx, START);
+  nfaPool[nfaIdx].start = firstStateIdx;
+  nfaPool[nfaIdx].accepting[0] = acceptingIdx;
+}
+
 static PoolOffset build_expr_op_nfa(PoolOffset operandOffset,
                                     OperandType operandType) {
   switch (operandType) {
@@ -296,19 +663,152 @@ static PoolOffset build_expr_op_nfa(PoolOffset operandOffset,
   case NON_TERMINAL:
     return build_non_terminal_nfa(operandOffset);
   case TERMINAL:
-    return build_terminal_nfa(termTable + operandOffset);
+    return build_terminal_nfa(termTable + operandOffset, FALSE);
+  case CASELESS_TERMINAL:
+    return build_terminal_nfa(termTable + operandOffset, TRUE);
+  case TAG:
+    return build_tag_nfa(operandOffset);
+  case CODE_POINTS:
+    return build_code_point_nfa(operandOffset);
+  case DICTIONARY:
+    return build_dictionary_nfa(operandOffset);
+  case COMPLEMENT: {
+    PoolOffset nfaIdx = build_non_terminal_nfa(operandOffset);
+    build_complement_nfa(nfaIdx);
+    return nfaIdx;
+  }
   case NOTHING:
     assert(FALSE && "Shouldn't have reached this!\n");
   }
 }
 
 static PoolOffset build_non_terminal_nfa(PoolOffset nontermIdx) {
+  // a linked non-terminal's cached NFA already has its decoder, see
+  // set_module_cache
+  if (nontermTable[nontermIdx].expr == LINKED_EXPR) {
+    nontermToNFAMap[nontermIdx] = load_cached_nfa(nfaFingerprints[nontermIdx]);
+    assert(nontermToNFAMap[nontermIdx] != -1 && "The NFA of a linked"
+           " non-terminal is missing from the cache!\n");
+    return nontermToNFAMap[nontermIdx];
+  }
+
   nontermToNFAMap[nontermIdx] =
     build_regex_expr_nfa(nontermTable[nontermIdx].expr);
 
+  if (nontermTable[nontermIdx].decoder != NO_DECODER) {
+    PoolOffset acceptingIdx = nfaPool[nontermToNFAMap[nontermIdx]].accepting[0];
+    nfaStatesPool[acceptingIdx].decoder = nontermTable[nontermIdx].decoder;
+  }
+
   return nontermToNFAMap[nontermIdx];
 }
 
+/// Appends the cached NFA of the non-terminal with the given fingerprint
+/// to the pools. An artifact stores the states and edges
+/// build_non_terminal_nfa added, their indices relative to the first of
+/// them. Returns the index of the NFA, or -1, leaving the pools as they
+/// were, if there's no valid artifact.
+static PoolOffset load_cached_nfa(uint64_t key) {
+  FILE *in = open_artifact(nfaCacheDir, NFA_ARTIFACT, key);
+
+  if (in == NULL) {
+    return -1;
+  }
+
+  PoolOffset firstState = currentNFAState;
+  PoolOffset firstEdge = currentNFAEdge;
+  // # states, # edges, start, accepting
+  int counts[4];
+  bool ok = fread(counts, sizeof(int), 4, in) == 4 && counts[0] > 0
+    && counts[1] >= 0 && counts[2] >= 0 && counts[2] < counts[0]
+    && counts[3] >= 0 && counts[3] < counts[0];
+
+  for (int s=0 ; ok && s<counts[0] ; s++) {
+    // type, decoder, # edges
+    int fields[3];
+    ok = fread(fields, sizeof(int), 3, in) == 3 && fields[2] >= 0
+      && fields[2] <= MAX_EDGES_PER_NODE;
+
+    if (!ok) {
+      break;
+    }
+
+    PoolOffset stateIdx = new_state((NFAStateType)fields[0]);
+    NFAStatePtr state = nfaStatesPool + stateIdx;
+    state->decoder = (DecoderType)fields[1];
+    state->numEdges = fields[2];
+    ok = fread(state->edges, sizeof(PoolOffset), state->numEdges, in)
+      == (size_t)state->numEdges;
+
+    for (int e=0 ; ok && e<state->numEdges ; e++) {
+      ok = state->edges[e] >= 0 && state->edges[e] < counts[1];
+      state->edges[e] += firstEdge;
+    }
+  }
+
+  for (int e=0 ; ok && e<counts[1] ; e++) {
+    PoolOffset edgeIdx = new_edge(0, EPSILON);
+    ok = fread(nfaEdgePool + edgeIdx, sizeof(NFAEdge), 1, in) == 1
+      && nfaEdgePool[edgeIdx].target >= 0
+      && nfaEdgePool[edgeIdx].target < counts[0];
+    nfaEdgePool[edgeIdx].target += firstState;
+  }
+
+  fclose(in);
+
+  if (!ok) {
+    currentNFAState = firstState;
+    currentNFAEdge = firstEdge;
+    return -1;
+  }
+
+  if (currentNFA == maxNFAs) {
+    grow_nfas_pool();
+  }
+
+  nfaPool[currentNFA].start = firstState + counts[2];
+  nfaPool[currentNFA].accepting[0] = firstState + counts[3];
+  nfaPool[currentNFA].numAccepting = 1;
+  return currentNFA++;
+}
+
+/// Stores the NFA build_non_terminal_nfa just built, see load_cached_nfa
+static void save_non_terminal_nfa(int nontermIdx, PoolOffset firstState,
+                                  PoolOffset firstEdge) {
+  ArtifactWriter writer;
+
+  if (!begin_artifact(&writer, nfaCacheDir, NFA_ARTIFACT,
+                      nfaFingerprints[nontermIdx])) {
+    return;
+  }
+
+  NFAPtr nfa = nfaPool + nontermToTokenNFAMap[nontermIdx];
+  int counts[4] = { currentNFAState - firstState, currentNFAEdge - firstEdge,
+                    nfa->start - firstState, nfa->accepting[0] - firstState };
+  fwrite(counts, sizeof(int), 4, writer.out);
+
+  for (PoolOffset s=firstState ; s<currentNFAState ; s++) {
+    NFAStatePtr state = nfaStatesPool + s;
+    int fields[3] = { state->type, state->decoder, state->numEdges };
+    PoolOffset edges[MAX_EDGES_PER_NODE];
+
+    for (int e=0 ; e<state->numEdges ; e++) {
+      edges[e] = state->edges[e] - firstEdge;
+    }
+
+    fwrite(fields, sizeof(int), 3, writer.out);
+    fwrite(edges, sizeof(PoolOffset), state->numEdges, writer.out);
+  }
+
+  for (PoolOffset e=firstEdge ; e<currentNFAEdge ; e++) {
+    NFAEdge edge = nfaEdgePool[e];
+    edge.target -= firstState;
+    fwrite(&edge, sizeof(NFAEdge), 1, writer.out);
+  }
+
+  end_artifact(&writer, TRUE);
+}
+
 static PoolOffset build_regex_expr_nfa(PoolOffset exprIdx) {
   assert(exprIdx != -1 && "Invalid expression!\n");
 
@@ -330,27 +830,52 @@ static PoolOffset build_regex_expr_nfa(PoolOffset exprIdx) {
   case ZERO_OR_MORE:
     build_closure_nfa(op1NFA);
     break;
+  case ONE_OR_MORE:
+    build_plus_nfa(op1NFA);
+    break;
+  case INTERSECT:
+    op2NFA = build_expr_op_nfa(expr->op2, expr->op2Type);
+    build_intersect_nfa(op1NFA, op2NFA);
+    break;
   }
 
   return op1NFA;
 }
 
 /// Build a chain NFA out of a mutli-characher terminal. Every symbol is
-/// concatenated to the next one.
-static PoolOffset build_terminal_nfa(char *terminal) {
-  size_t len = strlen(terminal);
-  assert(len > 0 && "Trying to build an NFA for an empty terminal");
+/// concatenated to the next one. If caseless is TRUE, a letter gets a
+/// second edge for its other case, i.e. a 2 byte set rather than an
+/// alternative, so the NFA doesn't grow with the number of letters.
+static PoolOffset build_terminal_nfa(char *terminal, bool caseless) {
+  // the empty terminal left by factor_literal_alternations for a literal
+  // that's a prefix of others, e.g. the < of < | <=, is a single epsilon
+  // edge
+  if (*terminal == '\0') {
+    PoolOffset nfaIdx = new_nfa();
+    NFA nfa = nfaPool[nfaIdx];
+    nfaStatesPool[nfa.start].edges[0] = new_edge(nfa.accepting[0], EPSILON);
+    nfaStatesPool[nfa.start].numEdges = 1;
+    return nfaIdx;
+  }
+
   PoolOffset startIdx = new_start_state();
   PoolOffset prevStateIdx = startIdx;
 
   while(*terminal != '\0') {
-    NFAStatePtr prevState = nfaStatesPool + prevStateIdx;
     PoolOffset currentStateIdx = new_state(INTERNAL);
+    NFAStatePtr prevState = nfaStatesPool + prevStateIdx;
 
     assert(prevState->numEdges == 0 && "This state should have 0 edges\n");
     prevState->edges[0] = new_edge(currentStateIdx, *terminal);
     prevState->numEdges = 1;
 
+    if (caseless && isalpha((unsigned char)*terminal)) {
+      char other = islower((unsigned char)*terminal)
+        ? toupper((unsigned char)*terminal) : tolower((unsigned char)*terminal);
+      prevState->edges[1] = new_edge(currentStateIdx, other);
+      prevState->numEdges = 2;
+    }
+
     prevStateIdx = currentStateIdx;
     terminal++;
   }
@@ -364,6 +889,270 @@ static PoolOffset build_terminal_nfa(char *terminal) {
   return nfaIdx;
 }
 
+/// Build the NFA for a tag, an epsilon edge marked with the tag's index
+///
+///        OUTPUT
+///    ---  eps   ===
+///  >| a | ---> | b |
+///    --- (tag)  ===
+static PoolOffset build_tag_nfa(int tag) {
+  PoolOffset nfaIdx = new_nfa();
+  NFA nfa = nfaPool[nfaIdx];
+  PoolOffset edgeIdx = new_edge(nfa.accepting[0], EPSILON);
+  nfaEdgePool[edgeIdx].tag = tag;
+  nfaStatesPool[nfa.start].edges[0] = edgeIdx;
+  nfaStatesPool[nfa.start].numEdges++;
+  return nfaIdx;
+}
+
+/// Build the NFA matching the UTF-8 encodings of a set of code points
+/// without an edge per code point. Every range is split into sequences
+/// of byte ranges (see split_utf8_sequences), which are added to a trie
+/// sharing their prefixes. The trie's nodes with the same edges are then
+/// merged bottom up, which shares the suffixes too, e.g. all the
+/// continuation bytes [80-bf] ending a sequence lead to the same state.
+/// The result is the minimal acyclic automaton of the sequences, each of
+/// its states becomes an NFA state.
+static PoolOffset build_code_point_nfa(PoolOffset setIdx) {
+  CodePointSetPtr sets;
+  CodePointRangePtr ranges;
+  get_code_point_sets(&sets, &ranges);
+  CodePointSetPtr set = sets + setIdx;
+
+  numUtf8Nodes = 1;
+  numUtf8Edges = 0;
+  utf8NodeFirstEdge[0] = -1;
+  utf8NodeLastEdge[0] = -1;
+
+  for (int i=0 ; i<set->numRanges ; i++) {
+    Utf8Sequence sequences[MAX_SEQUENCES_PER_RANGE];
+    int numSequences = split_utf8_sequences(ranges[set->first + i],
+                                            sequences);
+
+    for (int j=0 ; j<numSequences ; j++) {
+      add_utf8_sequence(sequences + j);
+    }
+  }
+
+  // children are always created after their parents, hence, visiting the
+  // nodes backwards merges the children first
+  memset(utf8NodeHashTable, -1, UTF8_HASH_SIZE*sizeof(int));
+
+  for (int n=numUtf8Nodes-1 ; n>=0 ; n--) {
+    merge_utf8_node(n);
+  }
+
+  PoolOffset nfaIdx = new_nfa();
+  PoolOffset acceptingIdx = nfaPool[nfaIdx].accepting[0];
+  utf8NodeState[0] = nfaPool[nfaIdx].start;
+
+  for (int n=1 ; n<numUtf8Nodes ; n++) {
+    if (utf8NodeCanon[n] == n) {
+      utf8NodeState[n] = new_state(INTERNAL);
+    }
+  }
+
+  for (int n=0 ; n<numUtf8Nodes ; n++) {
+    if (utf8NodeCanon[n] != n) {
+      continue;
+    }
+
+    PoolOffset stateIdx = utf8NodeState[n];
+
+    for (int e=utf8NodeFirstEdge[n] ; e!=-1 ; e=utf8EdgeNext[e]) {
+      PoolOffset target = utf8EdgeChild[e] == UTF8_LEAF ? acceptingIdx
+        : utf8NodeState[utf8EdgeChild[e]];
+      append_edge(&stateIdx, new_range_edge(target, (char)utf8EdgeFirst[e],
+                                            (char)utf8EdgeLast[e]));
+    }
+  }
+
+  return nfaIdx;
+}
+
+/// Grafts the minimal DFA of a dictionary (see load_dictionary) as is, a
+/// state per DFA state and a range edge per run of bytes leading to the
+/// same state. The root becomes the start state and the final states get
+/// an epsilon edge to the accepting state.
+static PoolOffset build_dictionary_nfa(PoolOffset dictIdx) {
+  DictStatePtr dictStates;
+  DictEdgePtr dictEdges;
+  DictionaryPtr dicts;
+  get_dictionary_tables(&dictStates, &dictEdges, &dicts);
+  DictionaryPtr dict = dicts + dictIdx;
+
+  PoolOffset nfaIdx = new_nfa();
+  PoolOffset acceptingIdx = nfaPool[nfaIdx].accepting[0];
+  // the root is the dictionary's last state, the states before it are
+  // created before their edges, which may add overflow states (see
+  // append_edge)
+  PoolOffset firstStateIdx = currentNFAState;
+
+  for (PoolOffset s=dict->first ; s<dict->root ; s++) {
+    new_state(INTERNAL);
+  }
+
+  for (PoolOffset s=dict->first ; s<=dict->root ; s++) {
+    DictStatePtr dictState = dictStates + s;
+    PoolOffset stateIdx = s == dict->root ? nfaPool[nfaIdx].start
+      : firstStateIdx + s - dict->first;
+
+    for (int e=0 ; e<dictState->numEdges ; ) {
+      DictEdgePtr edge = dictEdges + dictState->firstEdge + e;
+      int last = edge->symbol;
+      e++;
+
+      while (e < dictState->numEdges
+             && dictEdges[dictState->firstEdge + e].symbol == last + 1
+             && dictEdges[dictState->firstEdge + e].target == edge->target) {
+        last++;
+        e++;
+      }
+
+      append_edge(&stateIdx, new_range_edge(firstStateIdx + edge->target
+                                            - dict->first,
+                                            (char)edge->symbol, (char)last));
+    }
+
+    if (dictState->final) {
+      append_edge(&stateIdx, new_edge(acceptingIdx, EPSILON));
+    }
+  }
+
+  return nfaIdx;
+}
+
+/// Adds a sequence to the trie. The sequences come in increasing order,
+/// hence, the only edge a sequence can share is the last one of a node.
+static void add_utf8_sequence(Utf8SequencePtr sequence) {
+  int nodeIdx = 0;
+
+  for (int i=0 ; i<sequence->length ; i++) {
+    bool isLast = i == sequence->length - 1;
+    int e = utf8NodeLastEdge[nodeIdx];
+
+    if (e != -1 && utf8EdgeFirst[e] == sequence->first[i]
+        && utf8EdgeLast[e] == sequence->last[i]
+        && (utf8EdgeChild[e] == UTF8_LEAF) == isLast) {
+      nodeIdx = utf8EdgeChild[e];
+      continue;
+    }
+
+    int childIdx = UTF8_LEAF;
+
+    if (!isLast) {
+      assert(numUtf8Nodes < MAX_UTF8_NODES && "UTF-8 trie ran out of"
+             " memory!\n");
+      childIdx = numUtf8Nodes++;
+      utf8NodeFirstEdge[childIdx] = -1;
+      utf8NodeLastEdge[childIdx] = -1;
+    }
+
+    add_utf8_edge(nodeIdx, sequence->first[i], sequence->last[i], childIdx);
+    nodeIdx = childIdx;
+  }
+}
+
+static int add_utf8_edge(int nodeIdx, unsigned char first, unsigned char last,
+                         int childIdx) {
+  assert(numUtf8Edges < MAX_UTF8_NODES && "UTF-8 trie ran out of"
+         " memory!\n");
+  int e = numUtf8Edges++;
+  utf8EdgeFirst[e] = first;
+  utf8EdgeLast[e] = last;
+  utf8EdgeChild[e] = childIdx;
+  utf8EdgeNext[e] = -1;
+
+  if (utf8NodeLastEdge[nodeIdx] == -1) {
+    utf8NodeFirstEdge[nodeIdx] = e;
+  } else {
+    utf8EdgeNext[utf8NodeLastEdge[nodeIdx]] = e;
+  }
+
+  utf8NodeLastEdge[nodeIdx] = e;
+  return e;
+}
+
+/// Points the node's edges at the nodes their children were merged into,
+/// joins adjacent edges that now lead to the same node, and merges the
+/// node into an earlier visited one with the same edges if there is one
+static void merge_utf8_node(int nodeIdx) {
+  unsigned int hash = 2166136261u;
+
+  for (int e=utf8NodeFirstEdge[nodeIdx] ; e!=-1 ; e=utf8EdgeNext[e]) {
+    if (utf8EdgeChild[e] != UTF8_LEAF) {
+      utf8EdgeChild[e] = utf8NodeCanon[utf8EdgeChild[e]];
+    }
+
+    int prev = e;
+
+    while (utf8EdgeNext[prev] != -1) {
+      int next = utf8EdgeNext[prev];
+      int nextChild = utf8EdgeChild[next] == UTF8_LEAF ? UTF8_LEAF
+        : utf8NodeCanon[utf8EdgeChild[next]];
+
+      if (nextChild != utf8EdgeChild[e]
+          || utf8EdgeFirst[next] != utf8EdgeLast[e] + 1) {
+        break;
+      }
+
+      utf8EdgeLast[e] = utf8EdgeLast[next];
+      utf8EdgeNext[e] = utf8EdgeNext[next];
+    }
+
+    hash = (hash ^ utf8EdgeFirst[e]) * 16777619u;
+    hash = (hash ^ utf8EdgeLast[e]) * 16777619u;
+    hash = (hash ^ (unsigned int)utf8EdgeChild[e]) * 16777619u;
+  }
+
+  unsigned int slot = hash % UTF8_HASH_SIZE;
+
+  while (utf8NodeHashTable[slot] != -1) {
+    if (same_utf8_edges(utf8NodeHashTable[slot], nodeIdx)) {
+      utf8NodeCanon[nodeIdx] = utf8NodeHashTable[slot];
+      return;
+    }
+
+    slot = (slot + 1) % UTF8_HASH_SIZE;
+  }
+
+  utf8NodeHashTable[slot] = nodeIdx;
+  utf8NodeCanon[nodeIdx] = nodeIdx;
+}
+
+static bool same_utf8_edges(int node1Idx, int node2Idx) {
+  int e1 = utf8NodeFirstEdge[node1Idx];
+  int e2 = utf8NodeFirstEdge[node2Idx];
+
+  while (e1 != -1 && e2 != -1) {
+    if (utf8EdgeFirst[e1] != utf8EdgeFirst[e2]
+        || utf8EdgeLast[e1] != utf8EdgeLast[e2]
+        || utf8EdgeChild[e1] != utf8EdgeChild[e2]) {
+      return FALSE;
+    }
+
+    e1 = utf8EdgeNext[e1];
+    e2 = utf8EdgeNext[e2];
+  }
+
+  return e1 == e2;
+}
+
+/// Adds an edge to a state built with an unknown number of edges, e.g.
+/// a range per lead byte. A full state gets an epsilon edge to a new
+/// overflow state, which stateIdx is then updated to.
+static void append_edge(PoolOffset *stateIdx, PoolOffset edgeIdx) {
+  if (nfaStatesPool[*stateIdx].numEdges == MAX_EDGES_PER_NODE - 1) {
+    PoolOffset overflowIdx = new_state(INTERNAL);
+    NFAStatePtr state = nfaStatesPool + *stateIdx;
+    state->edges[state->numEdges++] = new_edge(overflowIdx, EPSILON);
+    *stateIdx = overflowIdx;
+  }
+
+  NFAStatePtr state = nfaStatesPool + *stateIdx;
+  state->edges[state->numEdges++] = edgeIdx;
+}
+
 /// Gets a free state from the pool and returns its index
 static PoolOffset new_start_state() {
   return new_state(START);
@@ -375,34 +1164,125 @@ static PoolOffset new_accepting_state() {
 }
 
 static PoolOffset new_state(NFAStateType type) {
-  assert(currentNFAState < MAX_NFA_STATES && "NFA states pool ran out of"
-         "memory!\n");
+  if (currentNFAState == maxNFAStates) {
+    grow_states_pool();
+  }
+
   nfaStatesPool[currentNFAState].type = type;
   nfaStatesPool[currentNFAState].numEdges = 0;
+  nfaStatesPool[currentNFAState].decoder = NO_DECODER;
+  nfaStatesPool[currentNFAState].owner = -1;
   return currentNFAState++;
 }
 
 static PoolOffset new_edge(PoolOffset target, char symbol) {
-  assert(currentNFAEdge < MAX_NFA_EDGES && "NFA edges pool ran out of"
-         "memory!\n");
+  if (currentNFAEdge == maxNFAEdges) {
+    grow_edges_pool();
+  }
+
   nfaEdgePool[currentNFAEdge].target = target;
   nfaEdgePool[currentNFAEdge].symbol = symbol;
+  nfaEdgePool[currentNFAEdge].last = symbol;
+  nfaEdgePool[currentNFAEdge].tag = NO_TAG;
   return currentNFAEdge++;
 }
 
+static PoolOffset new_range_edge(PoolOffset target, char first, char last) {
+  PoolOffset edgeIdx = new_edge(target, first);
+  nfaEdgePool[edgeIdx].last = last;
+  return edgeIdx;
+}
+
 static PoolOffset new_nfa() {
-  assert(currentNFA < MAX_NFAS && "NFA pool ran out of memory!\n");
+  if (currentNFA == maxNFAs) {
+    grow_nfas_pool();
+  }
+
   nfaPool[currentNFA].start = new_start_state();
   nfaPool[currentNFA].accepting[0] = new_accepting_state();
   nfaPool[currentNFA].numAccepting++;
   return currentNFA++;
 }
 
+/// Grows the states pool, and the arrays indexed by state along with it,
+/// to make room for one more state
+static void grow_states_pool() {
+  int capacity = grow_capacity(maxNFAStates, currentNFAState + 1,
+                               INITIAL_NFA_STATES, MAX_NFA_STATES,
+                               "NFA states");
+  nfaStatesPool = resize_pool(nfaStatesPool, maxNFAStates, capacity,
+                              sizeof(NFAState));
+  reachedStates = resize_pool(reachedStates, maxNFAStates, capacity,
+                              sizeof(int));
+  walkStack = resize_pool(walkStack, maxNFAStates, capacity,
+                          sizeof(PoolOffset));
+  keptStates = resize_pool(keptStates, maxNFAStates, capacity,
+                           sizeof(bool));
+  reverseStates = resize_pool(reverseStates, maxNFAStates, capacity,
+                              sizeof(PoolOffset));
+  reverseTails = resize_pool(reverseTails, maxNFAStates, capacity,
+                             sizeof(PoolOffset));
+  maxNFAStates = capacity;
+}
+
+static void grow_edges_pool() {
+  int capacity = grow_capacity(maxNFAEdges, currentNFAEdge + 1,
+                               INITIAL_NFA_EDGES, MAX_NFA_EDGES, "NFA edges");
+  nfaEdgePool = resize_pool(nfaEdgePool, maxNFAEdges, capacity,
+                            sizeof(NFAEdge));
+  maxNFAEdges = capacity;
+}
+
+static void grow_nfas_pool() {
+  int capacity = grow_capacity(maxNFAs, currentNFA + 1, INITIAL_NFAS,
+                               MAX_NFAS, "NFAs");
+  nfaPool = resize_pool(nfaPool, maxNFAs, capacity, sizeof(NFA));
+  maxNFAs = capacity;
+}
+
 static void update_state_type(PoolOffset stateIdx, NFAStateType newType) {
   NFAStatePtr state = nfaStatesPool + stateIdx;
   state->type = newType;
 }
 
+/// Returns TRUE if some path leads from one state to the other
+static bool reaches(PoolOffset fromIdx, PoolOffset toIdx) {
+  int numEdges;
+  currentWalk++;
+  mark_reachable(fromIdx, &numEdges);
+  return reachedStates[toIdx] == currentWalk;
+}
+
+/// Marks the states reachable from the given one that the current walk
+/// hasn't reached yet. Returns their number and adds their edges to
+/// numEdges.
+static int mark_reachable(PoolOffset stateIdx, int *numEdges) {
+  int numStates = 0;
+  int top = 0;
+
+  if (reachedStates[stateIdx] != currentWalk) {
+    reachedStates[stateIdx] = currentWalk;
+    walkStack[top++] = stateIdx;
+  }
+
+  while (top > 0) {
+    NFAStatePtr state = nfaStatesPool + walkStack[--top];
+    numStates++;
+    *numEdges += state->numEdges;
+
+    for (int i=0 ; i<state->numEdges ; i++) {
+      PoolOffset target = nfaEdgePool[state->edges[i]].target;
+
+      if (reachedStates[target] != currentWalk) {
+        reachedStates[target] = currentWalk;
+        walkStack[top++] = target;
+      }
+    }
+  }
+
+  return numStates;
+}
+
 #if DEBUG
 static void print_nfa(PoolOffset nfaIdx) {
   print_state(nfaPool[nfaIdx].start);
@@ -467,8 +1347,14 @@ static void print_state_graphviz(PoolOffset stateIdx) {
 
   for (int i=0 ; i<state->numEdges ; i++) {
     NFAEdge edge = nfaEdgePool[state->edges[i]];
-    if (edge.symbol == '\0') {
+    if (edge.symbol == '\0' && edge.tag != NO_TAG) {
+      log("\tS%d -> S%d [label=\"eps #%d\"];\n", stateIdx, edge.target,
+          edge.tag);
+    } else if (edge.symbol == '\0') {
       log("\tS%d -> S%d [label=\"eps\"];\n", stateIdx, edge.target);
+    } else if (edge.last != edge.symbol) {
+      log("\tS%d -> S%d [label=\"0x%02x-0x%02x\"];\n", stateIdx,
+          edge.target, (unsigned char)edge.symbol, (unsigned char)edge.last);
     } else {
       log("\tS%d -> S%d [label=\"%c\"];\n", stateIdx, edge.target,
           edge.symbol);
@@ -483,7 +1369,7 @@ static void print_state_graphviz(PoolOffset stateIdx) {
   /* state->visited = FALSE; */ 
 }
 
-static void print_nfa_graphviz(PoolOffset nfaIdx) {
+void print_nfa_graphviz(PoolOffset nfaIdx) {
   log("digraph NFA {\n");
   print_state_graphviz(nfaPool[nfaIdx].start);
   log("}\n");
@@ -0,0 +1,122 @@
+#include <time.h>
+#include "../include/passes.h"
+
+static int count_size(PassKind kind, int *numEdges);
+static double now_seconds();
+
+static Pass passes[] = {
+  { "factor-literals", AST_PASS,
+    "share the prefixes of alternations of literals",
+    factor_literal_alternations },
+  { "plus-closures", AST_PASS,
+    "rewrite x x* into x+, building x's NFA once",
+    fold_plus_closures },
+  { "dead-rules", NFA_PASS,
+    "drop the rules that can't match anything",
+    remove_dead_rules },
+  { "epsilon-bypass", NFA_PASS,
+    "skip the states whose only edge is an epsilon one",
+    bypass_epsilon_states }
+};
+
+#define NUM_PASSES ((int)(sizeof(passes) / sizeof(Pass)))
+
+void init_default_pipeline(PipelinePtr pipeline) {
+  for (int i=0 ; i<NUM_PASSES ; i++) {
+    pipeline->passes[i] = i;
+  }
+
+  pipeline->numPasses = NUM_PASSES;
+  pipeline->printStats = FALSE;
+}
+
+bool parse_pipeline(PipelinePtr pipeline, char *list) {
+  int parsed[MAX_PIPELINE_PASSES];
+  int numParsed = 0;
+
+  if (strcmp(list, "none") == 0) {
+    pipeline->numPasses = 0;
+    return TRUE;
+  }
+
+  for (char *name=list ; *name!='\0' ; ) {
+    int len = strcspn(name, ",");
+    int passIdx = -1;
+
+    for (int i=0 ; i<NUM_PASSES ; i++) {
+      if ((int)strlen(passes[i].name) == len
+          && strncmp(passes[i].name, name, len) == 0) {
+        passIdx = i;
+        break;
+      }
+    }
+
+    if (passIdx == -1 || numParsed == MAX_PIPELINE_PASSES) {
+      fprintf(stderr, "Error: unknown pass %.*s\n", len, name);
+      return FALSE;
+    }
+
+    parsed[numParsed++] = passIdx;
+    name += len + (name[len] == ',');
+  }
+
+  memcpy(pipeline->passes, parsed, numParsed*sizeof(int));
+  pipeline->numPasses = numParsed;
+  return TRUE;
+}
+
+void run_passes(PipelinePtr pipeline, PassKind kind) {
+  for (int i=0 ; i<pipeline->numPasses ; i++) {
+    PassPtr pass = passes + pipeline->passes[i];
+
+    if (pass->kind != kind) {
+      continue;
+    }
+
+    if (!pipeline->printStats) {
+      pass->run();
+      continue;
+    }
+
+    int edgesBefore, edgesAfter;
+    int sizeBefore = count_size(kind, &edgesBefore);
+    double start = now_seconds();
+    int numChanges = pass->run();
+    double ms = (now_seconds() - start) * 1e3;
+    int sizeAfter = count_size(kind, &edgesAfter);
+
+    if (kind == AST_PASS) {
+      fprintf(stderr, "%-16s %8.3f ms  %d changes, %d -> %d expressions\n",
+              pass->name, ms, numChanges, sizeBefore, sizeAfter);
+    } else {
+      fprintf(stderr, "%-16s %8.3f ms  %d changes, %d -> %d states, "
+              "%d -> %d edges\n", pass->name, ms, numChanges, sizeBefore,
+              sizeAfter, edgesBefore, edgesAfter);
+    }
+  }
+}
+
+void print_passes(FILE *out) {
+  for (int i=0 ; i<NUM_PASSES ; i++) {
+    fprintf(out, "%-16s %s  %s\n", passes[i].name,
+            passes[i].kind == AST_PASS ? "ast" : "nfa",
+            passes[i].description);
+  }
+}
+
+/// The size a pass of the given kind works on, the NFAs are only counted
+/// from the states their start states reach
+static int count_size(PassKind kind, int *numEdges) {
+  if (kind == AST_PASS) {
+    *numEdges = 0;
+    return count_rule_exprs();
+  }
+
+  return count_nfa_states(numEdges);
+}
+
+static double now_seconds() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
@@ -0,0 +1,334 @@
+#include "../include/product.h"
+
+/// The & and ~ operators can't be expressed with Thompson's Construction,
+/// hence, their operands are turned into small DFAs, combined with the
+/// classic constructions (the product for &, swapping the accepting
+/// states of a complete DFA for ~), and build_nfa turns the result back
+/// into a part of the NFA. For more details check "Introduction to
+/// Automata Theory, Languages, and Computation", 2006, Section 4.2.1
+
+#define MAX_PRODUCT_SET_POOL (1 << 20)
+#define PRODUCT_HASH_SIZE    (2 * MAX_PRODUCT_STATES)
+
+static ProductState productStatesPool[MAX_PRODUCT_STATES];
+static PoolOffset currentProductState = 0;
+
+static ProductDFA productDFAPool[MAX_PRODUCT_DFAS];
+static PoolOffset currentProductDFA = 0;
+
+// the NFA state sets of determinize_nfa's states and the state pairs of
+// intersect_dfas' states, both indexed by the state
+static PoolOffset setPool[MAX_PRODUCT_SET_POOL];
+static PoolOffset currentSetEntry = 0;
+static PoolOffset stateSet[MAX_PRODUCT_STATES];
+static int stateSetSize[MAX_PRODUCT_STATES];
+static PoolOffset statePair[MAX_PRODUCT_STATES][2];
+
+// open addressing hash table from sets (or pairs) to states, -1 marks an
+// empty slot
+static PoolOffset stateHashTable[PRODUCT_HASH_SIZE];
+
+static NFAStatePtr nfaStateTable;
+static NFAEdgePtr nfaEdgeTable;
+
+// see closure_of in dfa.c. Like there, the arrays indexed by NFA state
+// cover the NFA states pool as of the last call to determinize_nfa.
+static int *closureMarks = NULL;
+static int closureMark = 0;
+static PoolOffset *closureStack = NULL;
+static PoolOffset *moveSeeds = NULL;
+static int maxNFAStates = 0;
+
+static PoolOffset new_product_dfa();
+static PoolOffset new_product_state(bool accepting);
+static int closure_of(PoolOffset *seeds, int numSeeds, PoolOffset *set);
+static PoolOffset find_or_add_set(PoolOffset *set, int setSize,
+                                  PoolOffset accepting);
+static PoolOffset find_or_add_pair(PoolOffset s1, PoolOffset s2);
+static void drop_dead_ends(PoolOffset dfaIdx);
+static int compare_offsets(const void *a, const void *b);
+
+PoolOffset determinize_nfa(NFAStatePtr _nfaStateTable, NFAEdgePtr _nfaEdgeTable,
+                           PoolOffset start, PoolOffset accepting) {
+  nfaStateTable = _nfaStateTable;
+  nfaEdgeTable = _nfaEdgeTable;
+  memset(stateHashTable, -1, PRODUCT_HASH_SIZE*sizeof(PoolOffset));
+
+  if (maxNFAStates < get_num_nfa_states()) {
+    int numNFAStates = get_num_nfa_states();
+    closureMarks = resize_pool(closureMarks, maxNFAStates, numNFAStates,
+                               sizeof(int));
+    closureStack = resize_pool(closureStack, maxNFAStates, numNFAStates,
+                               sizeof(PoolOffset));
+    moveSeeds = resize_pool(moveSeeds, maxNFAStates, numNFAStates,
+                            sizeof(PoolOffset));
+    maxNFAStates = numNFAStates;
+  }
+
+  PoolOffset dfaIdx = new_product_dfa();
+  PoolOffset firstStateIdx = currentProductState;
+  PoolOffset *set = setPool + currentSetEntry;
+  int setSize = closure_of(&start, 1, set);
+  productDFAPool[dfaIdx].start = find_or_add_set(set, setSize, accepting);
+
+  // new states are appended to the pool as they are discovered, which
+  // makes the pool itself the work list
+  for (PoolOffset s=firstStateIdx ; s<currentProductState ; s++) {
+    productStatesPool[s].transitions[EPSILON] = DEAD_STATE;
+
+    for (int c=EPSILON+1 ; c<ALPHABET_SIZE ; c++) {
+      int numSeeds = 0;
+      closureMark++;
+
+      for (int i=0 ; i<stateSetSize[s] ; i++) {
+        NFAStatePtr nfaState = nfaStateTable + setPool[stateSet[s] + i];
+
+        for (int j=0 ; j<nfaState->numEdges ; j++) {
+          NFAEdgePtr edge = nfaEdgeTable + nfaState->edges[j];
+
+          if (edge->symbol != EPSILON && (unsigned char)edge->symbol <= c
+              && c <= (unsigned char)edge->last
+              && closureMarks[edge->target] != closureMark) {
+            closureMarks[edge->target] = closureMark;
+            moveSeeds[numSeeds++] = edge->target;
+          }
+        }
+      }
+
+      PoolOffset target = DEAD_STATE;
+
+      if (numSeeds > 0) {
+        set = setPool + currentSetEntry;
+        setSize = closure_of(moveSeeds, numSeeds, set);
+        target = find_or_add_set(set, setSize, accepting);
+      }
+
+      productStatesPool[s].transitions[c] = target;
+    }
+  }
+
+  productDFAPool[dfaIdx].numStates = currentProductState - firstStateIdx;
+  return dfaIdx;
+}
+
+PoolOffset intersect_dfas(PoolOffset dfa1Idx, PoolOffset dfa2Idx) {
+  memset(stateHashTable, -1, PRODUCT_HASH_SIZE*sizeof(PoolOffset));
+
+  PoolOffset dfaIdx = new_product_dfa();
+  PoolOffset firstStateIdx = currentProductState;
+  productDFAPool[dfaIdx].start = find_or_add_pair(productDFAPool[dfa1Idx].start,
+                                                  productDFAPool[dfa2Idx].start);
+
+  for (PoolOffset s=firstStateIdx ; s<currentProductState ; s++) {
+    for (int c=0 ; c<ALPHABET_SIZE ; c++) {
+      PoolOffset t1 = productStatesPool[statePair[s][0]].transitions[c];
+      PoolOffset t2 = productStatesPool[statePair[s][1]].transitions[c];
+      PoolOffset target = DEAD_STATE;
+
+      if (t1 != DEAD_STATE && t2 != DEAD_STATE) {
+        target = find_or_add_pair(t1, t2);
+      }
+
+      productStatesPool[s].transitions[c] = target;
+    }
+  }
+
+  productDFAPool[dfaIdx].numStates = currentProductState - firstStateIdx;
+  drop_dead_ends(dfaIdx);
+  return dfaIdx;
+}
+
+PoolOffset complement_dfa(PoolOffset dfaIdx) {
+  ProductDFA dfa = productDFAPool[dfaIdx];
+  PoolOffset newDFAIdx = new_product_dfa();
+  PoolOffset firstStateIdx = currentProductState;
+
+  for (int s=0 ; s<dfa.numStates ; s++) {
+    new_product_state(!productStatesPool[dfa.start + s].accepting);
+  }
+
+  PoolOffset sink = new_product_state(TRUE);
+
+  for (int s=0 ; s<=dfa.numStates ; s++) {
+    ProductStatePtr state = productStatesPool + firstStateIdx + s;
+    state->transitions[EPSILON] = DEAD_STATE;
+
+    for (int c=EPSILON+1 ; c<ALPHABET_SIZE ; c++) {
+      PoolOffset target = s == dfa.numStates ? DEAD_STATE
+        : productStatesPool[dfa.start + s].transitions[c];
+      state->transitions[c] = target == DEAD_STATE ? sink
+        : firstStateIdx + target - dfa.start;
+    }
+  }
+
+  productDFAPool[newDFAIdx].start = firstStateIdx;
+  productDFAPool[newDFAIdx].numStates = dfa.numStates + 1;
+  return newDFAIdx;
+}
+
+void get_product_tables(ProductStatePtr *states, ProductDFAPtr *dfas) {
+  *states = productStatesPool;
+  *dfas = productDFAPool;
+}
+
+void free_product_dfas() {
+  currentProductState = 0;
+  currentProductDFA = 0;
+  currentSetEntry = 0;
+}
+
+static PoolOffset new_product_dfa() {
+  assert(currentProductDFA < MAX_PRODUCT_DFAS && "Product DFA pool ran out"
+         " of memory!\n");
+  return currentProductDFA++;
+}
+
+static PoolOffset new_product_state(bool accepting) {
+  assert(currentProductState < MAX_PRODUCT_STATES && "Product DFA states"
+         " pool ran out of memory!\n");
+  productStatesPool[currentProductState].accepting = accepting;
+  return currentProductState++;
+}
+
+/// Computes the epsilon closure of the seed states and stores it sorted
+/// in set. Returns the size of the closure.
+static int closure_of(PoolOffset *seeds, int numSeeds, PoolOffset *set) {
+  int setSize = 0;
+  int stackSize = 0;
+  closureMark++;
+
+  for (int i=0 ; i<numSeeds ; i++) {
+    if (closureMarks[seeds[i]] != closureMark) {
+      closureMarks[seeds[i]] = closureMark;
+      closureStack[stackSize++] = seeds[i];
+    }
+  }
+
+  while (stackSize > 0) {
+    PoolOffset stateIdx = closureStack[--stackSize];
+    NFAStatePtr state = nfaStateTable + stateIdx;
+    assert(currentSetEntry+setSize < MAX_PRODUCT_SET_POOL
+           && "Product set pool ran out of memory!\n");
+    set[setSize++] = stateIdx;
+
+    for (int i=0 ; i<state->numEdges ; i++) {
+      NFAEdgePtr edge = nfaEdgeTable + state->edges[i];
+
+      if (edge->symbol == EPSILON && closureMarks[edge->target] != closureMark) {
+        closureMarks[edge->target] = closureMark;
+        closureStack[stackSize++] = edge->target;
+      }
+    }
+  }
+
+  qsort(set, setSize, sizeof(PoolOffset), compare_offsets);
+  return setSize;
+}
+
+/// Looks up the state standing for the given set of NFA states, see
+/// find_or_add_dfa_state in dfa.c. A new state accepts if its set
+/// contains accepting.
+static PoolOffset find_or_add_set(PoolOffset *set, int setSize,
+                                  PoolOffset accepting) {
+  unsigned int hash = 2166136261u;
+
+  for (int i=0 ; i<setSize ; i++) {
+    hash = (hash ^ (unsigned int)set[i]) * 16777619u;
+  }
+
+  unsigned int slot = hash % PRODUCT_HASH_SIZE;
+
+  while (stateHashTable[slot] != -1) {
+    PoolOffset candidate = stateHashTable[slot];
+
+    if (stateSetSize[candidate] == setSize
+        && memcmp(setPool + stateSet[candidate], set,
+                  setSize*sizeof(PoolOffset)) == 0) {
+      return candidate;
+    }
+
+    slot = (slot + 1) % PRODUCT_HASH_SIZE;
+  }
+
+  bool accepts = bsearch(&accepting, set, setSize, sizeof(PoolOffset),
+                         compare_offsets) != NULL;
+  PoolOffset stateIdx = new_product_state(accepts);
+  stateSet[stateIdx] = set - setPool;
+  stateSetSize[stateIdx] = setSize;
+  currentSetEntry += setSize;
+  stateHashTable[slot] = stateIdx;
+  return stateIdx;
+}
+
+/// Like find_or_add_set but for the pairs of intersect_dfas. A new state
+/// accepts if both states of its pair do.
+static PoolOffset find_or_add_pair(PoolOffset s1, PoolOffset s2) {
+  unsigned int hash = 2166136261u;
+  hash = (hash ^ (unsigned int)s1) * 16777619u;
+  hash = (hash ^ (unsigned int)s2) * 16777619u;
+  unsigned int slot = hash % PRODUCT_HASH_SIZE;
+
+  while (stateHashTable[slot] != -1) {
+    PoolOffset candidate = stateHashTable[slot];
+
+    if (statePair[candidate][0] == s1 && statePair[candidate][1] == s2) {
+      return candidate;
+    }
+
+    slot = (slot + 1) % PRODUCT_HASH_SIZE;
+  }
+
+  PoolOffset stateIdx = new_product_state(productStatesPool[s1].accepting
+                                          && productStatesPool[s2].accepting);
+  statePair[stateIdx][0] = s1;
+  statePair[stateIdx][1] = s2;
+  stateHashTable[slot] = stateIdx;
+  return stateIdx;
+}
+
+/// Removes the transitions to states from which no accepting state can be
+/// reached, e.g. the pairs of an identifier and a keyword's dead end.
+/// They would otherwise become NFA states that only slow down the subset
+/// construction.
+static void drop_dead_ends(PoolOffset dfaIdx) {
+  ProductDFA dfa = productDFAPool[dfaIdx];
+  bool live[MAX_PRODUCT_STATES];
+  bool changed = TRUE;
+
+  for (int s=0 ; s<dfa.numStates ; s++) {
+    live[s] = productStatesPool[dfa.start + s].accepting;
+  }
+
+  while (changed) {
+    changed = FALSE;
+
+    for (int s=0 ; s<dfa.numStates ; s++) {
+      ProductStatePtr state = productStatesPool + dfa.start + s;
+
+      for (int c=0 ; c<ALPHABET_SIZE && !live[s] ; c++) {
+        if (state->transitions[c] != DEAD_STATE
+            && live[state->transitions[c] - dfa.start]) {
+          live[s] = TRUE;
+          changed = TRUE;
+        }
+      }
+    }
+  }
+
+  for (int s=0 ; s<dfa.numStates ; s++) {
+    ProductStatePtr state = productStatesPool + dfa.start + s;
+
+    for (int c=0 ; c<ALPHABET_SIZE ; c++) {
+      if (state->transitions[c] != DEAD_STATE
+          && !live[state->transitions[c] - dfa.start]) {
+        state->transitions[c] = DEAD_STATE;
+      }
+    }
+  }
+}
+
+static int compare_offsets(const void *a, const void *b) {
+  PoolOffset x = *(const PoolOffset *)a;
+  PoolOffset y = *(const PoolOffset *)b;
+  return (x > y) - (x < y);
+}
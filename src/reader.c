@@ -0,0 +1,388 @@
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "../include/reader.h"
+
+#if defined(__linux__) && defined(HAVE_LINUX_IO_URING_H)
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#define USE_IO_URING 1
+#else
+#define USE_IO_URING 0
+#endif
+
+bool read_file_pread(const char *path, char **buf, long *size) {
+  int fd = open(path, O_RDONLY);
+  struct stat st;
+
+  if (fd < 0 || fstat(fd, &st) != 0) {
+    fprintf(stderr, "Error: cannot read %s\n", path);
+
+    if (fd >= 0) {
+      close(fd);
+    }
+
+    return FALSE;
+  }
+
+  *size = st.st_size;
+  // 1 extra byte so that an empty file still gets a valid buffer
+  *buf = malloc(*size + 1);
+  assert(*buf != NULL && "Out of memory!\n");
+  long done = 0;
+
+  while (done < *size) {
+    ssize_t n = pread(fd, *buf + done, *size - done, done);
+
+    if (n <= 0) {
+      break;
+    }
+
+    done += n;
+  }
+
+  close(fd);
+
+  if (done != *size) {
+    fprintf(stderr, "Error: cannot read %s\n", path);
+    free(*buf);
+    *buf = NULL;
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+#if USE_IO_URING
+
+/// The kernel and the reader share the rings, the reader only produces
+/// submissions and only consumes completions. The ring heads and tails
+/// are read and written with acquire/release semantics as required by
+/// io_uring(7).
+typedef struct Ring {
+  int fd;
+  unsigned *sqHead;
+  unsigned *sqTail;
+  unsigned *sqMask;
+  unsigned *sqArray;
+  struct io_uring_sqe *sqes;
+  unsigned *cqHead;
+  unsigned *cqTail;
+  unsigned *cqMask;
+  struct io_uring_cqe *cqes;
+  void *sqRing;
+  size_t sqRingSize;
+  void *cqRing;
+  size_t cqRingSize;
+  size_t sqesSize;
+  // submitted but not yet completed requests
+  int inFlight;
+  // queued but not yet submitted requests
+  int toSubmit;
+} Ring, *RingPtr;
+
+typedef enum {
+  OPEN_OP,
+  STATX_OP,
+  READ_OP,
+  CLOSE_OP
+} ReadOpType;
+
+// the request type is kept in the low bits of the user data, the file
+// index in the rest
+#define OP_BITS 2
+
+typedef struct PendingFile {
+  int fd;
+  struct statx stx;
+  int completed;
+  bool failed;
+} PendingFile, *PendingFilePtr;
+
+static bool setup_ring(RingPtr ring, unsigned entries);
+static void teardown_ring(RingPtr ring);
+static struct io_uring_sqe *next_sqe(RingPtr ring, int fileIdx,
+                                     ReadOpType type);
+static int submit_and_wait(RingPtr ring, unsigned minComplete);
+static bool next_cqe(RingPtr ring, struct io_uring_cqe *cqe);
+static void finish_read(InputFilePtr input, PendingFilePtr file, int res,
+                        InputReadyCallback ready, void *arg);
+
+bool read_files_uring(InputFilePtr *files, int numFiles, int queueDepth,
+                      InputReadyCallback ready, void *arg) {
+  Ring ring;
+  int window = queueDepth / 4;
+
+  if (window < 1 || !setup_ring(&ring, (unsigned)queueDepth)) {
+    return FALSE;
+  }
+
+  PendingFilePtr pending = calloc(window, sizeof(PendingFile));
+  assert(pending != NULL && "Out of memory!\n");
+  struct io_uring_cqe cqe;
+
+  for (int first=0 ; first<numFiles ; first+=window) {
+    int count = numFiles - first < window ? numFiles - first : window;
+
+    // stage 1: open and query the size of every file of the window. The
+    // closes queued by the previous window go out with these requests.
+    for (int i=0 ; i<count ; i++) {
+      PendingFilePtr file = pending + i;
+      file->fd = -1;
+      file->completed = 0;
+      file->failed = FALSE;
+
+      struct io_uring_sqe *sqe = next_sqe(&ring, i, OPEN_OP);
+      sqe->opcode = IORING_OP_OPENAT;
+      sqe->fd = AT_FDCWD;
+      sqe->addr = (unsigned long)files[first+i]->path;
+      sqe->open_flags = O_RDONLY;
+
+      sqe = next_sqe(&ring, i, STATX_OP);
+      sqe->opcode = IORING_OP_STATX;
+      sqe->fd = AT_FDCWD;
+      sqe->addr = (unsigned long)files[first+i]->path;
+      sqe->len = STATX_SIZE;
+      sqe->off = (unsigned long)&file->stx;
+    }
+
+    // stage 2: read every file that was opened, as soon as both of its
+    // requests complete
+    int opened = 0;
+    int stage1Left = 2 * count;
+
+    while (stage1Left > 0) {
+      submit_and_wait(&ring, 1);
+
+      while (next_cqe(&ring, &cqe)) {
+        int fileIdx = (int)(cqe.user_data >> OP_BITS);
+        ReadOpType type = (ReadOpType)(cqe.user_data & ((1 << OP_BITS) - 1));
+
+        if (type == CLOSE_OP) {
+          continue;
+        }
+
+        // the read of a file whose requests completed earlier
+        if (type == READ_OP) {
+          opened--;
+          finish_read(files[first+fileIdx], pending + fileIdx, cqe.res,
+                      ready, arg);
+          continue;
+        }
+
+        PendingFilePtr file = pending + fileIdx;
+        stage1Left--;
+
+        if (cqe.res < 0) {
+          file->failed = TRUE;
+        } else if (type == OPEN_OP) {
+          file->fd = cqe.res;
+        }
+
+        // wait for the other request of this file
+        if (++file->completed < 2 || file->failed) {
+          continue;
+        }
+
+        InputFilePtr input = files[first+fileIdx];
+        input->size = (long)file->stx.stx_size;
+
+        // a single read request is limited to 2^31 bytes, leave
+        // bigger files to the pread fallback
+        if (input->size >= (1L << 31)) {
+          file->failed = TRUE;
+          continue;
+        }
+
+        input->buf = malloc(input->size + 1);
+        assert(input->buf != NULL && "Out of memory!\n");
+
+        struct io_uring_sqe *sqe = next_sqe(&ring, fileIdx, READ_OP);
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = file->fd;
+        sqe->addr = (unsigned long)input->buf;
+        sqe->len = (unsigned)input->size;
+        sqe->off = 0;
+        opened++;
+      }
+    }
+
+    // stage 3: hand the files over as their reads complete and queue
+    // their closes
+    while (opened > 0) {
+      submit_and_wait(&ring, 1);
+
+      while (next_cqe(&ring, &cqe)) {
+        int fileIdx = (int)(cqe.user_data >> OP_BITS);
+        ReadOpType type = (ReadOpType)(cqe.user_data & ((1 << OP_BITS) - 1));
+
+        if (type != READ_OP) {
+          continue;
+        }
+
+        opened--;
+        finish_read(files[first+fileIdx], pending + fileIdx, cqe.res, ready,
+                    arg);
+      }
+    }
+
+    for (int i=0 ; i<count ; i++) {
+      PendingFilePtr file = pending + i;
+      InputFilePtr input = files[first+i];
+
+      if (file->fd != -1) {
+        struct io_uring_sqe *sqe = next_sqe(&ring, i, CLOSE_OP);
+        sqe->opcode = IORING_OP_CLOSE;
+        sqe->fd = file->fd;
+      }
+
+      // fall back to pread. This also reports the actual error, if any.
+      if (file->failed) {
+        free(input->buf);
+        input->buf = NULL;
+
+        if (!read_file_pread(input->path, &input->buf, &input->size)) {
+          input->buf = NULL;
+        }
+
+        ready(input, arg);
+      }
+    }
+  }
+
+  // flush the closes of the last window
+  while (ring.toSubmit > 0 || ring.inFlight > 0) {
+    submit_and_wait(&ring, ring.inFlight > 0 ? 1 : 0);
+
+    while (next_cqe(&ring, &cqe));
+  }
+
+  free(pending);
+  teardown_ring(&ring);
+  return TRUE;
+}
+
+static bool setup_ring(RingPtr ring, unsigned entries) {
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  memset(ring, 0, sizeof(Ring));
+
+  ring->fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+
+  // e.g. ENOSYS on old kernels or EPERM when disabled by a sandbox
+  if (ring->fd < 0) {
+    return FALSE;
+  }
+
+  ring->sqRingSize = params.sq_off.array + params.sq_entries*sizeof(unsigned);
+  ring->cqRingSize = params.cq_off.cqes
+    + params.cq_entries*sizeof(struct io_uring_cqe);
+  ring->sqesSize = params.sq_entries*sizeof(struct io_uring_sqe);
+
+  ring->sqRing = mmap(NULL, ring->sqRingSize, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+  ring->cqRing = mmap(NULL, ring->cqRingSize, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+  ring->sqes = mmap(NULL, ring->sqesSize, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+
+  if (ring->sqRing == MAP_FAILED || ring->cqRing == MAP_FAILED
+      || ring->sqes == MAP_FAILED) {
+    teardown_ring(ring);
+    return FALSE;
+  }
+
+  char *sq = ring->sqRing;
+  char *cq = ring->cqRing;
+  ring->sqHead = (unsigned*)(sq + params.sq_off.head);
+  ring->sqTail = (unsigned*)(sq + params.sq_off.tail);
+  ring->sqMask = (unsigned*)(sq + params.sq_off.ring_mask);
+  ring->sqArray = (unsigned*)(sq + params.sq_off.array);
+  ring->cqHead = (unsigned*)(cq + params.cq_off.head);
+  ring->cqTail = (unsigned*)(cq + params.cq_off.tail);
+  ring->cqMask = (unsigned*)(cq + params.cq_off.ring_mask);
+  ring->cqes = (struct io_uring_cqe*)(cq + params.cq_off.cqes);
+  return TRUE;
+}
+
+static void teardown_ring(RingPtr ring) {
+  if (ring->sqRing != NULL && ring->sqRing != MAP_FAILED) {
+    munmap(ring->sqRing, ring->sqRingSize);
+  }
+
+  if (ring->cqRing != NULL && ring->cqRing != MAP_FAILED) {
+    munmap(ring->cqRing, ring->cqRingSize);
+  }
+
+  if (ring->sqes != NULL && (void*)ring->sqes != MAP_FAILED) {
+    munmap(ring->sqes, ring->sqesSize);
+  }
+
+  close(ring->fd);
+}
+
+/// Queues a cleared submission for the given file and request type. The
+/// caller fills in the rest of it.
+static struct io_uring_sqe *next_sqe(RingPtr ring, int fileIdx,
+                                     ReadOpType type) {
+  unsigned tail = *ring->sqTail;
+  unsigned idx = tail & *ring->sqMask;
+  struct io_uring_sqe *sqe = ring->sqes + idx;
+
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->user_data = ((unsigned long)fileIdx << OP_BITS) | type;
+  ring->sqArray[idx] = idx;
+  __atomic_store_n(ring->sqTail, tail + 1, __ATOMIC_RELEASE);
+  ring->toSubmit++;
+  return sqe;
+}
+
+static int submit_and_wait(RingPtr ring, unsigned minComplete) {
+  int ret;
+
+  do {
+    ret = (int)syscall(__NR_io_uring_enter, ring->fd, ring->toSubmit,
+                       minComplete, IORING_ENTER_GETEVENTS, NULL, 0);
+  } while (ret < 0 && errno == EINTR);
+
+  assert(ret >= 0 && "io_uring_enter failed!\n");
+  ring->inFlight += ret;
+  ring->toSubmit -= ret;
+  return ret;
+}
+
+static bool next_cqe(RingPtr ring, struct io_uring_cqe *cqe) {
+  unsigned head = *ring->cqHead;
+
+  if (head == __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE)) {
+    return FALSE;
+  }
+
+  *cqe = ring->cqes[head & *ring->cqMask];
+  __atomic_store_n(ring->cqHead, head + 1, __ATOMIC_RELEASE);
+  ring->inFlight--;
+  return TRUE;
+}
+
+/// Hands a file over if its read got all of it, otherwise leaves it to
+/// the pread fallback
+static void finish_read(InputFilePtr input, PendingFilePtr file, int res,
+                        InputReadyCallback ready, void *arg) {
+  if (res != input->size) {
+    file->failed = TRUE;
+  } else {
+    ready(input, arg);
+  }
+}
+
+#else
+
+bool read_files_uring(InputFilePtr *files, int numFiles, int queueDepth,
+                      InputReadyCallback ready, void *arg) {
+  return FALSE;
+}
+
+#endif
@@ -1,28 +1,127 @@
 #include "../include/utils.h"
 #include "../include/regex.h"
-
-#define fatal_error(msg, ...)                                   \
-  fprintf(stderr, "Error %d:%d: ", currentLine, currentColumn); \
-  fprintf(stderr, (msg), ## __VA_ARGS__);                       \
+#include "../include/dictionary.h"
+#include "../include/hash.h"
+#include "../include/artifacts.h"
+
+#define fatal_error(msg, ...)                               \
+  fprintf(stderr, "Error %s%d:%d: ", currentFile, currentLine, \
+          currentColumn);                                   \
+  fprintf(stderr, (msg), ## __VA_ARGS__);                   \
   exit(1)
 
-#define warning(msg, ...)                                         \
-  fprintf(stderr, "Warning %d:%d: ", currentLine, currentColumn); \
+#define warning(msg, ...)                                     \
+  fprintf(stderr, "Warning %s%d:%d: ", currentFile, currentLine, \
+          currentColumn);                                     \
   fprintf(stderr, (msg), ## __VA_ARGS__);
 
+#define MAIN_MODULE      0
+#define MAX_MODULE_DEPS  32
+
+/// A file an imported module depends on, which has to be unchanged for
+/// the module's artifact to be linked
+typedef struct ModuleDep {
+  char path[MAX_MODULE_PATH];
+  // the version of an imported module or the hash of a dictionary
+  uint64_t version;
+  bool dictionary;
+} ModuleDep, *ModuleDepPtr;
+
+/// A spec file imported with @import (see set_module_cache), module
+/// MAIN_MODULE being the spec itself. The same content imported through
+/// different paths is the same module.
+typedef struct Module {
+  char path[MAX_MODULE_PATH];
+  // the hash of the file, which keys the module's artifact
+  uint64_t key;
+  // the key combined with the versions of the module's dependencies
+  uint64_t version;
+  // bit m is set if the rules of module m are visible in this one
+  uint64_t visible;
+  // the tags the module's rules use, directly or through its imports
+  uint32_t tags;
+  // linked or parsed, a module importing itself isn't
+  bool ready;
+  // parsed rather than linked, see save_module_artifacts
+  bool parsed;
+  // a rule was parsed already, imports must come first
+  bool hasRules;
+  int numDeps;
+  ModuleDep deps[MAX_MODULE_DEPS];
+} Module, *ModulePtr;
+
 static NonTerminal nonterms[MAX_NONTERMS];
 
 /// A memory pool for storing all terminals. A '\0' separates a terminal from its
-/// next neighbor.
+/// next neighbor. Every distinct terminal is stored once (see
+/// intern_terminal), its offset in the pool being its id.
 static char termPool[MAX_TOTAL_TERM_LEN];
 static char *currentTermStart = termPool;
+// the ids of the terminals stored so far, hashed by their strings, -1
+// marks an empty slot
+#define TERM_HASH_SIZE (2 * MAX_TOTAL_TERM_LEN)
+static PoolOffset termHashTable[TERM_HASH_SIZE];
+
+/// A memory pool for storing the action blocks, NUL terminated
+static char actionPool[MAX_TOTAL_ACTION_LEN];
+static char *currentActionStart = actionPool;
+
+static Tag tags[MAX_TAGS];
+static int numTags = 0;
+
+static Mode modes[MAX_MODES] = { { "INITIAL" } };
+static int numModes = 1;
+
+static CodePointSet codePointSets[MAX_CODE_POINT_SETS];
+static int numCodePointSets = 0;
+static CodePointRange codePointRanges[MAX_CODE_POINT_RANGES];
+static PoolOffset currentCodePointRange = 0;
 
 static Expression exprPool[MAX_NESTED_EXPRS];
 static int freeExprIdx = 0;
 
+/// The expressions of the spec form a DAG: identical subexpressions, e.g.
+/// the $digit $digit* of several rules, are stored once. The table hashes
+/// every distinct expression stored so far (see share_expr), -1 marks an
+/// empty slot.
+#define EXPR_HASH_SIZE (2 * MAX_NESTED_EXPRS)
+static PoolOffset exprHashTable[EXPR_HASH_SIZE];
+// a copy of the expressions of the rule being shared
+static Expression ruleExprs[MAX_REGEX_LEN];
+// the expressions the current walk over the rules (e.g. factor_expr)
+// already went through, a shared expression is only rewritten once
+static bool visitedExprs[MAX_NESTED_EXPRS];
+
+// fingerprint_non_terminals' results, a non-terminal is only hashed once
+static uint64_t *nontermFingerprints;
+static bool fingerprinted[MAX_NONTERMS];
+
+static Module modules[MAX_MODULES];
+static int numModules = 1;
+// the module whose lines are being parsed or linked
+static int currentModule = MAIN_MODULE;
+// the module defining each non-terminal
+static int nontermModules[MAX_NONTERMS];
+// the fingerprints linked non-terminals were stored with
+static uint64_t linkedFingerprints[MAX_NONTERMS];
+// the rules of the module being linked, see link_module
+static NonTerminal linkedRules[MAX_NONTERMS];
+static uint64_t linkedRuleFingerprints[MAX_NONTERMS];
+// see get_spec_files
+static char specFiles[MAX_SPEC_FILES][MAX_REGEX_LEN];
+static int numSpecFiles = 0;
+// see set_module_cache
+static const char *moduleCacheDir = NULL;
+static uint64_t moduleKeySeed = 0;
+
 static int currentLine = 0;
 static int currentColumn = 0;
+// the path of the module being parsed followed by a colon, empty for the
+// spec itself
+static char currentFile[MAX_MODULE_PATH + 1] = "";
 static int currentNonterm = 0;
+// the non-terminal whose body is being parsed
+static int bodyNontermIdx = -1;
 static int memcpy2(char *dest, char *src, int numBytes, char escapeChar,
             char *toEscape, char *toPut);
 
@@ -31,22 +130,58 @@ static int memcpy2(char *dest, char *src, int numBytes, char escapeChar,
 #define moveRegexPtr(regex)        \
   ((++currentColumn), (++regex))
 
+static void parse_lines(FILE *in);
 static void parse_regex(char *regex);
+static void parse_import(char *regex);
+static int import_module(char *path);
+static bool link_module(int moduleIdx);
+static void parse_module(int moduleIdx, char *content, long size);
+static void enter_module(int moduleIdx, char *importerFile);
+static void leave_module(int importerIdx, char *importerFile);
+static void make_visible(int moduleIdx);
+static bool is_visible(int nontermIdx);
+static int find_visible_nonterm(char *name, int nameSize);
+static void add_dependency(char *path, uint64_t version, bool dictionary);
+static uint64_t module_version(int moduleIdx);
+static void add_spec_file(const char *path);
+static char *read_whole_file(const char *path, long *size);
+static bool file_version(const char *path, uint64_t *version);
 static int parse_header(char **regexPtr);
+static void parse_annotation(char **regexPtr, int nontermIdx);
+static int parse_mode(char **regexPtr, char end);
+static int intern_mode(char *name, int nameSize);
+static int intern_tag(char *name, int nameSize);
+static PoolOffset parse_code_points(char *operand, int operandSize);
+static PoolOffset parse_dictionary(char *operand, int operandSize);
+static char *parse_action(char *regex);
 static void parse_body(char **regexPtr, int nontermIdx);
 static OperandType parse_operand(char **regexPtr, PoolOffset *res);
 static OperatorType parse_operator(char **regexPtr);
 static void log_expr(PoolOffset exprIdx);
+static PoolOffset share_expr(PoolOffset exprIdx, PoolOffset firstExprIdx);
+static unsigned int hash_operand(unsigned int hash, PoolOffset op,
+                                 OperandType type);
+static bool same_operand(PoolOffset op1, PoolOffset op2, OperandType type);
+static void factor_expr(PoolOffset exprIdx, int *numFactored);
+static PoolOffset factor_literals(PoolOffset *literals, int numLiterals,
+                                  int depth, OperandType type);
+static void fold_plus_expr(PoolOffset exprIdx, int *numFolded);
+static int count_exprs(PoolOffset exprIdx);
+static uint64_t fingerprint_non_terminal(int nontermIdx);
+static uint64_t fingerprint_operand(PoolOffset op, OperandType type,
+                                   uint64_t hash);
+static uint64_t fingerprint_dictionary(PoolOffset dictIdx, uint64_t hash);
+static PoolOffset new_expr(OperatorType type, PoolOffset op1,
+                           OperandType op1Type);
+static PoolOffset intern_terminal(char *terminal, int size);
+static int compare_terminals(const void *a, const void *b);
 
 int parse_regex_spec(FILE *in, NonTerminalPtr *nontermTable,
                      ExpressionPtr *exprTable, char **termTable) {
-  char regexSpecLine[MAX_REGEX_LEN];
-
-  while (fgets(regexSpecLine, MAX_REGEX_LEN, in) != NULL) {
-    currentLine++;
-    currentColumn = 0;
-    parse_regex(regexSpecLine);
-  }
+  memset(exprHashTable, -1, EXPR_HASH_SIZE*sizeof(PoolOffset));
+  memset(termHashTable, -1, TERM_HASH_SIZE*sizeof(PoolOffset));
+  modules[MAIN_MODULE].ready = TRUE;
+  parse_lines(in);
 
   if (nontermTable != NULL) {
     *nontermTable = nonterms;
@@ -57,6 +192,572 @@ int parse_regex_spec(FILE *in, NonTerminalPtr *nontermTable,
   return currentNonterm;
 }
 
+void set_module_cache(const char *dir, uint64_t passesKey) {
+  moduleCacheDir = dir;
+  moduleKeySeed = passesKey;
+}
+
+int get_spec_files(const char **paths) {
+  for (int i=0 ; i<numSpecFiles ; i++) {
+    paths[i] = specFiles[i];
+  }
+
+  return numSpecFiles;
+}
+
+void save_module_artifacts(uint64_t *fingerprints) {
+  if (moduleCacheDir == NULL) {
+    return;
+  }
+
+  for (int m=MAIN_MODULE+1 ; m<numModules ; m++) {
+    ModulePtr module = modules + m;
+    ArtifactWriter writer;
+
+    if (!module->parsed || !begin_artifact(&writer, moduleCacheDir,
+                                           MODULE_ARTIFACT, module->key)) {
+      continue;
+    }
+
+    fwrite(&module->numDeps, sizeof(int), 1, writer.out);
+
+    for (int d=0 ; d<module->numDeps ; d++) {
+      fwrite(&module->deps[d].dictionary, sizeof(bool), 1, writer.out);
+      fwrite(&module->deps[d].version, sizeof(uint64_t), 1, writer.out);
+      write_artifact_string(writer.out, module->deps[d].path);
+    }
+
+    int numModuleTags = 0;
+
+    for (int t=0 ; t<numTags ; t++) {
+      numModuleTags += (module->tags >> t) & 1;
+    }
+
+    fwrite(&numModuleTags, sizeof(int), 1, writer.out);
+
+    for (int t=0 ; t<numTags ; t++) {
+      if ((module->tags >> t) & 1) {
+        fwrite(&t, sizeof(int), 1, writer.out);
+        fwrite(&tags[t].trailing, sizeof(bool), 1, writer.out);
+        write_artifact_string(writer.out, tags[t].name);
+      }
+    }
+
+    int numRules = 0;
+
+    for (int i=0 ; i<currentNonterm ; i++) {
+      numRules += nontermModules[i] == m;
+    }
+
+    fwrite(&numRules, sizeof(int), 1, writer.out);
+
+    for (int i=0 ; i<currentNonterm ; i++) {
+      NonTerminalPtr nonterm = nonterms + i;
+
+      if (nontermModules[i] != m) {
+        continue;
+      }
+
+      int fields[4] = { nonterm->decoder, nonterm->skip, nonterm->nocase,
+                        nonterm->trailTag };
+      write_artifact_string(writer.out, nonterm->name);
+      fwrite(fields, sizeof(int), 4, writer.out);
+      fwrite(fingerprints + i, sizeof(uint64_t), 1, writer.out);
+      write_artifact_string(writer.out, modes[nonterm->mode].name);
+      write_artifact_string(writer.out, nonterm->nextMode == NO_MODE ? NULL
+                            : modes[nonterm->nextMode].name);
+      write_artifact_string(writer.out, nonterm->action);
+    }
+
+    end_artifact(&writer, TRUE);
+  }
+}
+
+int factor_literal_alternations() {
+  int numFactored = 0;
+  memset(visitedExprs, 0, sizeof(visitedExprs));
+
+  for (int i=0 ; i<currentNonterm ; i++) {
+    if (nonterms[i].complete && nonterms[i].expr != LINKED_EXPR) {
+      factor_expr(nonterms[i].expr, &numFactored);
+    }
+  }
+
+  return numFactored;
+}
+
+int fold_plus_closures() {
+  int numFolded = 0;
+  memset(visitedExprs, 0, sizeof(visitedExprs));
+
+  for (int i=0 ; i<currentNonterm ; i++) {
+    if (nonterms[i].complete && nonterms[i].expr != LINKED_EXPR) {
+      fold_plus_expr(nonterms[i].expr, &numFolded);
+    }
+  }
+
+  return numFolded;
+}
+
+int count_rule_exprs() {
+  int numExprs = 0;
+  memset(visitedExprs, 0, sizeof(visitedExprs));
+
+  for (int i=0 ; i<currentNonterm ; i++) {
+    if (nonterms[i].complete && nonterms[i].expr != LINKED_EXPR) {
+      numExprs += count_exprs(nonterms[i].expr);
+    }
+  }
+
+  return numExprs;
+}
+
+void fingerprint_non_terminals(uint64_t *fingerprints) {
+  nontermFingerprints = fingerprints;
+  memset(fingerprinted, 0, sizeof(fingerprinted));
+
+  for (int i=0 ; i<currentNonterm ; i++) {
+    fingerprint_non_terminal(i);
+  }
+}
+
+int get_tags(TagPtr *tagTable) {
+  if (tagTable != NULL) {
+    *tagTable = tags;
+  }
+
+  return numTags;
+}
+
+int get_modes(ModePtr *modeTable) {
+  if (modeTable != NULL) {
+    *modeTable = modes;
+  }
+
+  return numModes;
+}
+
+int get_code_point_sets(CodePointSetPtr *sets, CodePointRangePtr *ranges) {
+  if (sets != NULL) {
+    *sets = codePointSets;
+    *ranges = codePointRanges;
+  }
+
+  return numCodePointSets;
+}
+
+/// Hash-conses an expression of the rule just parsed, stored in ruleExprs
+/// at exprIdx - firstExprIdx: its nested expressions are shared first,
+/// then the expression itself is looked up. Returns the index of the
+/// existing identical expression, or of the copy added to the pool.
+static PoolOffset share_expr(PoolOffset exprIdx, PoolOffset firstExprIdx) {
+  Expression expr = ruleExprs[exprIdx - firstExprIdx];
+
+  if (expr.op1Type == NESTED_EXPRESSION) {
+    expr.op1 = share_expr(expr.op1, firstExprIdx);
+  }
+
+  if (expr.op2Type == NESTED_EXPRESSION) {
+    expr.op2 = share_expr(expr.op2, firstExprIdx);
+  }
+
+  unsigned int hash = 2166136261u;
+  hash = (hash ^ (unsigned int)expr.type) * 16777619u;
+  hash = hash_operand(hash, expr.op1, expr.op1Type);
+  hash = hash_operand(hash, expr.op2, expr.op2Type);
+  unsigned int slot = hash % EXPR_HASH_SIZE;
+
+  while (exprHashTable[slot] != -1) {
+    ExpressionPtr candidate = exprPool + exprHashTable[slot];
+
+    if (candidate->type == expr.type && candidate->op1Type == expr.op1Type
+        && candidate->op2Type == expr.op2Type
+        && same_operand(candidate->op1, expr.op1, expr.op1Type)
+        && same_operand(candidate->op2, expr.op2, expr.op2Type)) {
+      return exprHashTable[slot];
+    }
+
+    slot = (slot + 1) % EXPR_HASH_SIZE;
+  }
+
+  assert(freeExprIdx < MAX_NESTED_EXPRS && "Expression pool is "
+         "out of memory!\n");
+  exprPool[freeExprIdx] = expr;
+  exprHashTable[slot] = freeExprIdx;
+  return freeExprIdx++;
+}
+
+/// Every operand but NOTHING is identified by its value, terminals
+/// included since they're interned
+static unsigned int hash_operand(unsigned int hash, PoolOffset op,
+                                 OperandType type) {
+  hash = (hash ^ (unsigned int)type) * 16777619u;
+
+  if (type != NOTHING) {
+    hash = (hash ^ (unsigned int)op) * 16777619u;
+  }
+
+  return hash;
+}
+
+static bool same_operand(PoolOffset op1, PoolOffset op2, OperandType type) {
+  return type == NOTHING || op1 == op2;
+}
+
+/// Factors the literals at the head of the alternation starting at the
+/// given expression, if it's one, then the rest of the expression
+static void factor_expr(PoolOffset exprIdx, int *numFactored) {
+  if (visitedExprs[exprIdx]) {
+    return;
+  }
+
+  visitedExprs[exprIdx] = TRUE;
+  ExpressionPtr expr = exprPool + exprIdx;
+  OperandType type = expr->op1Type;
+  PoolOffset literals[MAX_REGEX_LEN / 2];
+  int numLiterals = 0;
+  PoolOffset rest = exprIdx;
+
+  // the chain a | b | c is (a | (b | (c))), the last alternative being
+  // the operand of a NO_OP
+  while (expr->op1Type == type
+         && (type == TERMINAL || type == CASELESS_TERMINAL)
+         && ((expr->type == OR && expr->op2Type == NESTED_EXPRESSION)
+             || (expr->type == NO_OP && expr->op2Type == NOTHING))) {
+    literals[numLiterals++] = expr->op1;
+
+    if (expr->type == NO_OP) {
+      rest = -1;
+      break;
+    }
+
+    rest = expr->op2;
+    expr = exprPool + rest;
+  }
+
+  if (numLiterals == 0) {
+    if (expr->op1Type == NESTED_EXPRESSION) {
+      factor_expr(expr->op1, numFactored);
+    }
+
+    if (expr->op2Type == NESTED_EXPRESSION) {
+      factor_expr(expr->op2, numFactored);
+    }
+
+    return;
+  }
+
+  // whatever follows the literals is an alternative on its own, e.g. the
+  // c d of a | b | c d
+  if (numLiterals >= 2) {
+    qsort(literals, numLiterals, sizeof(PoolOffset), compare_terminals);
+    int numUnique = 1;
+    bool shared = FALSE;
+
+    for (int i=1 ; i<numLiterals ; i++) {
+      char *prev = termPool + literals[numUnique-1];
+
+      if (literals[numUnique-1] == literals[i]) {
+        shared = TRUE;
+        continue;
+      }
+
+      shared |= prev[0] == termPool[literals[i]];
+      literals[numUnique++] = literals[i];
+    }
+
+    if (shared) {
+      PoolOffset factoredIdx = factor_literals(literals, numUnique, 0, type);
+
+      if (rest == -1) {
+        exprPool[exprIdx] = exprPool[factoredIdx];
+      } else {
+        ExpressionPtr head = exprPool + exprIdx;
+        head->type = OR;
+        head->op1 = factoredIdx;
+        head->op1Type = NESTED_EXPRESSION;
+        head->op2 = rest;
+        head->op2Type = NESTED_EXPRESSION;
+      }
+
+      (*numFactored)++;
+    }
+  }
+
+  if (rest != -1) {
+    factor_expr(rest, numFactored);
+  }
+}
+
+/// Builds the alternation of the suffixes starting at depth of the given
+/// sorted and distinct literals, which share their first depth bytes.
+/// The literals are grouped by their next byte, a group of several
+/// literals becomes their longest common prefix followed by the
+/// alternation of what's left of them. Returns the index of the chain.
+static PoolOffset factor_literals(PoolOffset *literals, int numLiterals,
+                                  int depth, OperandType type) {
+  PoolOffset chainIdx = -1;
+  PoolOffset lastIdx = -1;
+
+  for (int i=0 ; i<numLiterals ; ) {
+    char *first = termPool + literals[i] + depth;
+    int j = i + 1;
+
+    // only the first literal can end at depth, the others are longer
+    while (*first != '\0' && j < numLiterals
+           && termPool[literals[j] + depth] == *first) {
+      j++;
+    }
+
+    PoolOffset altIdx;
+
+    if (j - i == 1) {
+      // also the empty suffix of a literal that's a prefix of the others
+      altIdx = new_expr(OR, intern_terminal(first, strlen(first)), type);
+    } else {
+      char *last = termPool + literals[j-1] + depth;
+      int prefixLen = 0;
+
+      while (first[prefixLen] == last[prefixLen]) {
+        prefixLen++;
+      }
+
+      PoolOffset concatIdx = new_expr(AND, intern_terminal(first, prefixLen),
+                                      type);
+      exprPool[concatIdx].op2 = factor_literals(literals + i, j - i,
+                                                depth + prefixLen, type);
+      exprPool[concatIdx].op2Type = NESTED_EXPRESSION;
+      altIdx = new_expr(OR, concatIdx, NESTED_EXPRESSION);
+    }
+
+    if (lastIdx == -1) {
+      chainIdx = altIdx;
+    } else {
+      exprPool[lastIdx].op2 = altIdx;
+      exprPool[lastIdx].op2Type = NESTED_EXPRESSION;
+    }
+
+    lastIdx = altIdx;
+    i = j;
+  }
+
+  exprPool[lastIdx].type = NO_OP;
+  return chainIdx;
+}
+
+/// Rewrites the given expression if it's the head of x x*, then the rest
+/// of the expression. The chain x x* y is (x ((x*) y)), the x* being
+/// nested in the expression following x's, so it's x+ y only if the x*
+/// is concatenated to what follows it, x (x* | y) isn't x+ | y.
+static void fold_plus_expr(PoolOffset exprIdx, int *numFolded) {
+  if (visitedExprs[exprIdx]) {
+    return;
+  }
+
+  visitedExprs[exprIdx] = TRUE;
+  ExpressionPtr expr = exprPool + exprIdx;
+
+  if (expr->type == AND && expr->op1Type != NESTED_EXPRESSION
+      && expr->op2Type == NESTED_EXPRESSION) {
+    ExpressionPtr next = exprPool + expr->op2;
+    ExpressionPtr star = next->op1Type == NESTED_EXPRESSION
+      ? exprPool + next->op1 : NULL;
+
+    if ((next->type == AND || next->type == NO_OP) && star != NULL
+        && star->type == ZERO_OR_MORE && star->op1Type == expr->op1Type
+        && same_operand(star->op1, expr->op1, expr->op1Type)) {
+      // the expression may be shared, its meaning doesn't change though
+      PoolOffset plusIdx = new_expr(ONE_OR_MORE, expr->op1, expr->op1Type);
+      expr->type = next->type;
+      expr->op1 = plusIdx;
+      expr->op1Type = NESTED_EXPRESSION;
+      expr->op2 = next->op2;
+      expr->op2Type = next->op2Type;
+      (*numFolded)++;
+    }
+  }
+
+  if (expr->op1Type == NESTED_EXPRESSION) {
+    fold_plus_expr(expr->op1, numFolded);
+  }
+
+  if (expr->op2Type == NESTED_EXPRESSION) {
+    fold_plus_expr(expr->op2, numFolded);
+  }
+}
+
+static int count_exprs(PoolOffset exprIdx) {
+  if (visitedExprs[exprIdx]) {
+    return 0;
+  }
+
+  visitedExprs[exprIdx] = TRUE;
+  ExpressionPtr expr = exprPool + exprIdx;
+  int numExprs = 1;
+
+  if (expr->op1Type == NESTED_EXPRESSION) {
+    numExprs += count_exprs(expr->op1);
+  }
+
+  if (expr->op2Type == NESTED_EXPRESSION) {
+    numExprs += count_exprs(expr->op2);
+  }
+
+  return numExprs;
+}
+
+static uint64_t fingerprint_non_terminal(int nontermIdx) {
+  if (fingerprinted[nontermIdx]) {
+    return nontermFingerprints[nontermIdx];
+  }
+
+  // a rule referring to itself can't be built anyway, the reference
+  // only has to terminate
+  fingerprinted[nontermIdx] = TRUE;
+  nontermFingerprints[nontermIdx] = 0;
+  NonTerminalPtr nonterm = nonterms + nontermIdx;
+
+  if (nonterm->expr == LINKED_EXPR) {
+    nontermFingerprints[nontermIdx] = linkedFingerprints[nontermIdx];
+    return linkedFingerprints[nontermIdx];
+  }
+
+  uint64_t hash = hash_bytes(&nonterm->decoder, sizeof(DecoderType),
+                             nonterm->complete);
+
+  if (nonterm->complete) {
+    hash = fingerprint_operand(nonterm->expr, NESTED_EXPRESSION, hash);
+  }
+
+  nontermFingerprints[nontermIdx] = hash;
+  return hash;
+}
+
+/// Hashes an operand into hash by its content rather than its offset,
+/// which changes whenever the rules before it change
+static uint64_t fingerprint_operand(PoolOffset op, OperandType type,
+                                   uint64_t hash) {
+  hash = hash_bytes(&type, sizeof(OperandType), hash);
+
+  switch (type) {
+  case NESTED_EXPRESSION: {
+    ExpressionPtr expr = exprPool + op;
+    hash = hash_bytes(&expr->type, sizeof(OperatorType), hash);
+    hash = fingerprint_operand(expr->op1, expr->op1Type, hash);
+    return fingerprint_operand(expr->op2, expr->op2Type, hash);
+  }
+  case NON_TERMINAL:
+  case COMPLEMENT: {
+    uint64_t fingerprint = fingerprint_non_terminal(op);
+    return hash_bytes(&fingerprint, sizeof(uint64_t), hash);
+  }
+  case TERMINAL:
+  case CASELESS_TERMINAL:
+    // including the NUL, which keeps a | bc apart from ab | c
+    return hash_bytes(termPool + op, strlen(termPool + op) + 1, hash);
+  case TAG:
+    // the NFA's edges carry the tag's index
+    return hash_bytes(&op, sizeof(PoolOffset), hash);
+  case CODE_POINTS: {
+    CodePointSetPtr set = codePointSets + op;
+    hash = hash_bytes(&set->numRanges, sizeof(int), hash);
+    return hash_bytes(codePointRanges + set->first,
+                      set->numRanges*sizeof(CodePointRange), hash);
+  }
+  case DICTIONARY:
+    return fingerprint_dictionary(op, hash);
+  case NOTHING:
+    break;
+  }
+
+  return hash;
+}
+
+/// Hashes the states of a dictionary's DFA, which build_dictionary_nfa
+/// copies as they are. Their targets are hashed relative to the
+/// dictionary's first state, which depends on the dictionaries loaded
+/// before it, e.g. by the modules a spec happened to parse.
+static uint64_t fingerprint_dictionary(PoolOffset dictIdx, uint64_t hash) {
+  DictStatePtr states;
+  DictEdgePtr edges;
+  DictionaryPtr dicts;
+  get_dictionary_tables(&states, &edges, &dicts);
+
+  for (PoolOffset s=dicts[dictIdx].first ; s<=dicts[dictIdx].root ; s++) {
+    hash = hash_bytes(&states[s].final, sizeof(bool), hash);
+    hash = hash_bytes(&states[s].numEdges, sizeof(int), hash);
+
+    for (int e=0 ; e<states[s].numEdges ; e++) {
+      DictEdgePtr edge = edges + states[s].firstEdge + e;
+      PoolOffset target = edge->target - dicts[dictIdx].first;
+      hash = hash_bytes(&edge->symbol, 1, hash);
+      hash = hash_bytes(&target, sizeof(PoolOffset), hash);
+    }
+  }
+
+  return hash;
+}
+
+static PoolOffset new_expr(OperatorType type, PoolOffset op1,
+                           OperandType op1Type) {
+  assert(freeExprIdx < MAX_NESTED_EXPRS && "Expression pool is "
+         "out of memory!\n");
+  ExpressionPtr expr = exprPool + freeExprIdx;
+  expr->type = type;
+  expr->op1 = op1;
+  expr->op1Type = op1Type;
+  expr->op2 = -1;
+  expr->op2Type = NOTHING;
+  return freeExprIdx++;
+}
+
+/// Returns the id of the terminal made of size bytes of the given string,
+/// copying them to the pool if it's a terminal not seen before. The string
+/// may already be at currentTermStart, e.g. parse_operand unescapes a
+/// terminal there, it's then only kept if it's new.
+static PoolOffset intern_terminal(char *terminal, int size) {
+  unsigned int hash = 2166136261u;
+
+  for (int i=0 ; i<size ; i++) {
+    hash = (hash ^ (unsigned char)terminal[i]) * 16777619u;
+  }
+
+  unsigned int slot = hash % TERM_HASH_SIZE;
+
+  while (termHashTable[slot] != -1) {
+    char *candidate = termPool + termHashTable[slot];
+
+    if (strncmp(candidate, terminal, size) == 0 && candidate[size] == '\0') {
+      return termHashTable[slot];
+    }
+
+    slot = (slot + 1) % TERM_HASH_SIZE;
+  }
+
+  assert(currentTermStart+size+1-termPool <= MAX_TOTAL_TERM_LEN
+         && "Terminal pool is out of memory!\n");
+  memmove(currentTermStart, terminal, size);
+  currentTermStart[size] = '\0';
+  termHashTable[slot] = currentTermStart - termPool;
+  currentTermStart += size + 1;
+  return termHashTable[slot];
+}
+
+static int compare_terminals(const void *a, const void *b) {
+  return strcmp(termPool + *(const PoolOffset*)a,
+                termPool + *(const PoolOffset*)b);
+}
+
+static void parse_lines(FILE *in) {
+  char regexSpecLine[MAX_REGEX_LEN];
+
+  while (fgets(regexSpecLine, MAX_REGEX_LEN, in) != NULL) {
+    currentLine++;
+    currentColumn = 0;
+    parse_regex(regexSpecLine);
+  }
+}
+
 /// Divides a regex into its individual components
 static void parse_regex(char *regex) {
   while (isspace(*regex)) {
@@ -72,12 +773,417 @@ static void parse_regex(char *regex) {
     return;
   }
 
+  if (strncmp(regex, "@import", 7) == 0) {
+    parse_import(regex);
+    return;
+  }
+
+  modules[currentModule].hasRules = TRUE;
+  // the action is cut off the line first, its code isn't a regex
+  char *action = parse_action(regex);
   int nontermIdx = parse_header(&regex);
+  nonterms[nontermIdx].action = action;
   parse_body(&regex, nontermIdx);
 
   nonterms[nontermIdx].complete = TRUE;
 }
 
+/// Parses an @import line, see set_module_cache
+static void parse_import(char *regex) {
+  if (currentModule != MAIN_MODULE && modules[currentModule].hasRules) {
+    fatal_error("Imports must come before the rules of a module\n");
+  }
+
+  for (int i=0 ; i<7 ; i++) {
+    moveRegexPtr(regex);
+  }
+
+  if (!isspace(*regex)) {
+    fatal_error("Missing path after @import\n");
+  }
+
+  while (isspace(*regex)) {
+    moveRegexPtr(regex);
+  }
+
+  char *pathStart = regex;
+
+  while (*regex != '\0' && !isspace(*regex)) {
+    moveRegexPtr(regex);
+  }
+
+  int pathSize = regex - pathStart;
+
+  if (pathSize == 0) {
+    fatal_error("Missing path after @import\n");
+  } else if (pathSize >= MAX_MODULE_PATH) {
+    fatal_error("Module path is longer than %d bytes\n", MAX_MODULE_PATH - 1);
+  }
+
+  while (isspace(*regex)) {
+    moveRegexPtr(regex);
+  }
+
+  if (*regex != '\0') {
+    fatal_error("Unexpected characters after the path of an import\n");
+  }
+
+  char path[MAX_MODULE_PATH];
+  memcpy(path, pathStart, pathSize);
+  path[pathSize] = '\0';
+  import_module(path);
+}
+
+/// Makes the rules of the module stored at the given path visible to the
+/// current module, linking or parsing the module first if it's new.
+/// Returns the module's index.
+static int import_module(char *path) {
+  long size;
+  // a missing module is watched too, it may be about to be written
+  add_spec_file(path);
+  char *content = read_whole_file(path, &size);
+
+  if (content == NULL) {
+    fatal_error("Can't open module %s\n", path);
+  }
+
+  uint64_t key = hash_bytes(content, size, moduleKeySeed);
+  int moduleIdx = -1;
+
+  for (int m=MAIN_MODULE+1 ; m<numModules ; m++) {
+    if (modules[m].key == key) {
+      moduleIdx = m;
+      break;
+    }
+  }
+
+  if (moduleIdx != -1 && !modules[moduleIdx].ready) {
+    fatal_error("Circular import of %s\n", path);
+  }
+
+  if (moduleIdx == -1) {
+    assert(numModules < MAX_MODULES && "Exceeded maximum number of"
+           " modules!\n");
+    moduleIdx = numModules++;
+    strcpy(modules[moduleIdx].path, path);
+    modules[moduleIdx].key = key;
+
+    if (moduleCacheDir == NULL || !link_module(moduleIdx)) {
+      parse_module(moduleIdx, content, size);
+    }
+
+    modules[moduleIdx].version = module_version(moduleIdx);
+    modules[moduleIdx].ready = TRUE;
+  }
+
+  free(content);
+  make_visible(moduleIdx);
+  add_dependency(path, modules[moduleIdx].version, FALSE);
+  return moduleIdx;
+}
+
+/// Adds the rules of a module from its artifact, written by
+/// save_module_artifacts: its dependencies are checked, importing the
+/// modules it imports again, then its rules are added as they were
+/// stored, without their expressions. Returns FALSE, adding no rule, if
+/// there's no artifact or it's stale.
+static bool link_module(int moduleIdx) {
+  ModulePtr module = modules + moduleIdx;
+  FILE *in = open_artifact(moduleCacheDir, MODULE_ARTIFACT, module->key);
+
+  if (in == NULL) {
+    return FALSE;
+  }
+
+  int importerIdx = currentModule;
+  char importerFile[MAX_MODULE_PATH + 1];
+  enter_module(moduleIdx, importerFile);
+  char *firstAction = currentActionStart;
+  int numDeps;
+  bool ok = fread(&numDeps, sizeof(int), 1, in) == 1 && numDeps >= 0
+    && numDeps <= MAX_MODULE_DEPS;
+
+  for (int d=0 ; ok && d<numDeps ; d++) {
+    ModuleDep dep;
+    ok = fread(&dep.dictionary, sizeof(bool), 1, in) == 1
+      && fread(&dep.version, sizeof(uint64_t), 1, in) == 1
+      && read_artifact_string(in, dep.path, MAX_MODULE_PATH, NULL);
+
+    if (ok && dep.dictionary) {
+      uint64_t version;
+      ok = file_version(dep.path, &version) && version == dep.version;
+      add_dependency(dep.path, dep.version, TRUE);
+      add_spec_file(dep.path);
+    } else if (ok) {
+      ok = modules[import_module(dep.path)].version == dep.version;
+    }
+  }
+
+  // the rules' NFAs carry the indices of the tags they use
+  int numModuleTags;
+  ok = ok && fread(&numModuleTags, sizeof(int), 1, in) == 1
+    && numModuleTags >= 0 && numModuleTags <= MAX_TAGS;
+
+  for (int t=0 ; ok && t<numModuleTags ; t++) {
+    int tagIdx;
+    bool trailing;
+    char name[MAX_NONTERM_NAME];
+    ok = fread(&tagIdx, sizeof(int), 1, in) == 1
+      && fread(&trailing, sizeof(bool), 1, in) == 1
+      && read_artifact_string(in, name, MAX_NONTERM_NAME, NULL)
+      && intern_tag(name, strlen(name)) == tagIdx;
+
+    if (ok) {
+      tags[tagIdx].trailing = trailing;
+    }
+  }
+
+  int numRules;
+  ok = ok && fread(&numRules, sizeof(int), 1, in) == 1 && numRules >= 0
+    && currentNonterm + numRules < MAX_NONTERMS;
+
+  for (int r=0 ; ok && r<numRules ; r++) {
+    NonTerminalPtr rule = linkedRules + r;
+    char mode[MAX_NONTERM_NAME];
+    char nextMode[MAX_NONTERM_NAME];
+    int fields[4];
+    bool noNextMode;
+    bool noAction;
+    ok = read_artifact_string(in, rule->name, MAX_NONTERM_NAME, NULL)
+      && fread(fields, sizeof(int), 4, in) == 4
+      && fread(linkedRuleFingerprints + r, sizeof(uint64_t), 1, in) == 1
+      && read_artifact_string(in, mode, MAX_NONTERM_NAME, NULL)
+      && read_artifact_string(in, nextMode, MAX_NONTERM_NAME, &noNextMode)
+      && read_artifact_string(in, currentActionStart, MAX_TOTAL_ACTION_LEN
+                              - (currentActionStart - actionPool),
+                              &noAction)
+      && fields[0] >= NO_DECODER && fields[0] <= INTERN_DECODER
+      && fields[3] >= NO_TAG && fields[3] < numTags;
+
+    if (!ok) {
+      break;
+    }
+
+    // the NFA may have been evicted from the cache since
+    FILE *nfa = open_artifact(moduleCacheDir, NFA_ARTIFACT,
+                              linkedRuleFingerprints[r]);
+    ok = nfa != NULL;
+
+    if (nfa != NULL) {
+      fclose(nfa);
+    }
+
+    rule->decoder = fields[0];
+    rule->skip = fields[1];
+    rule->nocase = fields[2];
+    rule->trailTag = fields[3];
+    rule->mode = intern_mode(mode, strlen(mode));
+    rule->nextMode = noNextMode ? NO_MODE : intern_mode(nextMode,
+                                                        strlen(nextMode));
+    rule->action = noAction ? NULL : currentActionStart;
+
+    if (!noAction) {
+      currentActionStart += strlen(currentActionStart) + 1;
+    }
+  }
+
+  fclose(in);
+
+  for (int r=0 ; ok && r<numRules ; r++) {
+    if (find_visible_nonterm(linkedRules[r].name,
+                             strlen(linkedRules[r].name)) != -1) {
+      fatal_error("Re-definition of a non-terminal: %s\n",
+                  linkedRules[r].name);
+    }
+
+    int nontermIdx = currentNonterm++;
+    nonterms[nontermIdx] = linkedRules[r];
+    nonterms[nontermIdx].expr = LINKED_EXPR;
+    nonterms[nontermIdx].complete = TRUE;
+    nonterms[nontermIdx].idx = nontermIdx;
+    nontermModules[nontermIdx] = moduleIdx;
+    linkedFingerprints[nontermIdx] = linkedRuleFingerprints[r];
+  }
+
+  if (!ok) {
+    // parsing the module imports its modules and tags again
+    currentActionStart = firstAction;
+    module->visible = 0;
+    module->tags = 0;
+    module->numDeps = 0;
+  }
+
+  leave_module(importerIdx, importerFile);
+  return ok;
+}
+
+/// Parses the lines of a module. Its rules can't refer to the ones it
+/// doesn't define or import.
+static void parse_module(int moduleIdx, char *content, long size) {
+  int importerIdx = currentModule;
+  int importerLine = currentLine;
+  char importerFile[MAX_MODULE_PATH + 1];
+  enter_module(moduleIdx, importerFile);
+  currentLine = 0;
+
+  if (size > 0) {
+    FILE *in = fmemopen(content, size, "r");
+    assert(in != NULL && "Can't read a module from memory!\n");
+    parse_lines(in);
+    fclose(in);
+  }
+
+  for (int i=0 ; i<currentNonterm ; i++) {
+    if (nontermModules[i] == moduleIdx && !nonterms[i].complete) {
+      fatal_error("Undefined non-terminal in a module: %s\n",
+                  nonterms[i].name);
+    }
+  }
+
+  modules[moduleIdx].parsed = TRUE;
+  leave_module(importerIdx, importerFile);
+  currentLine = importerLine;
+}
+
+/// Makes the given module the current one, saving the importer's
+/// currentFile, so that errors point into the module
+static void enter_module(int moduleIdx, char *importerFile) {
+  strcpy(importerFile, currentFile);
+  snprintf(currentFile, sizeof(currentFile), "%s:", modules[moduleIdx].path);
+  currentModule = moduleIdx;
+}
+
+static void leave_module(int importerIdx, char *importerFile) {
+  strcpy(currentFile, importerFile);
+  currentModule = importerIdx;
+}
+
+/// Makes the rules of the given module and of the modules it imports
+/// visible to the current module. A name can only refer to one rule.
+static void make_visible(int moduleIdx) {
+  uint64_t imported = ((uint64_t)1 << moduleIdx) | modules[moduleIdx].visible;
+
+  for (int i=0 ; i<currentNonterm ; i++) {
+    // a module imported through several others is only visible once
+    if (((imported >> nontermModules[i]) & 1) == 0 || is_visible(i)) {
+      continue;
+    }
+
+    if (find_visible_nonterm(nonterms[i].name,
+                             strlen(nonterms[i].name)) != -1) {
+      fatal_error("%s of module %s is already defined\n", nonterms[i].name,
+                  modules[moduleIdx].path);
+    }
+  }
+
+  modules[currentModule].visible |= imported;
+  modules[currentModule].tags |= modules[moduleIdx].tags;
+}
+
+static bool is_visible(int nontermIdx) {
+  int moduleIdx = nontermModules[nontermIdx];
+  return moduleIdx == currentModule
+    || ((modules[currentModule].visible >> moduleIdx) & 1);
+}
+
+/// Returns the index of the non-terminal with the given name visible to
+/// the current module, or -1
+static int find_visible_nonterm(char *name, int nameSize) {
+  for (int i=0 ; i<currentNonterm ; i++) {
+    // the name must match exactly, not only as a prefix, e.g. $char
+    // shouldn't match $char_literal
+    if (memcmp(nonterms[i].name, name, nameSize) == 0
+        && nonterms[i].name[nameSize] == '\0' && is_visible(i)) {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+/// Records a file the current module depends on, see ModuleDep. The spec
+/// itself has no artifact, its dependencies aren't needed.
+static void add_dependency(char *path, uint64_t version, bool dictionary) {
+  if (currentModule == MAIN_MODULE) {
+    return;
+  }
+
+  ModulePtr module = modules + currentModule;
+  assert(module->numDeps < MAX_MODULE_DEPS && "Exceeded maximum number of"
+         " module dependencies!\n");
+  ModuleDepPtr dep = module->deps + module->numDeps++;
+  strcpy(dep->path, path);
+  dep->version = version;
+  dep->dictionary = dictionary;
+}
+
+/// Records a file the compilation depends on, once
+static void add_spec_file(const char *path) {
+  for (int i=0 ; i<numSpecFiles ; i++) {
+    if (strcmp(specFiles[i], path) == 0) {
+      return;
+    }
+  }
+
+  assert(numSpecFiles < MAX_SPEC_FILES && "Exceeded maximum number of"
+         " files a spec reads!\n");
+  strcpy(specFiles[numSpecFiles++], path);
+}
+
+static uint64_t module_version(int moduleIdx) {
+  ModulePtr module = modules + moduleIdx;
+  uint64_t version = module->key;
+
+  for (int d=0 ; d<module->numDeps ; d++) {
+    version = hash_bytes(&module->deps[d].version, sizeof(uint64_t), version);
+  }
+
+  return version;
+}
+
+/// Returns the content of a file in a heap allocated buffer, or NULL if
+/// it can't be read
+static char *read_whole_file(const char *path, long *size) {
+  FILE *in = fopen(path, "rb");
+
+  if (in == NULL) {
+    return NULL;
+  }
+
+  if (fseek(in, 0, SEEK_END) != 0 || (*size = ftell(in)) < 0) {
+    fclose(in);
+    return NULL;
+  }
+
+  rewind(in);
+  // 1 extra byte so that an empty file still gets a valid buffer
+  char *content = malloc(*size + 1);
+  assert(content != NULL && "Out of memory!\n");
+  bool ok = fread(content, 1, *size, in) == (size_t)*size;
+  fclose(in);
+
+  if (!ok) {
+    free(content);
+    return NULL;
+  }
+
+  return content;
+}
+
+/// Sets version to the hash of a file's content, e.g. a dictionary's
+static bool file_version(const char *path, uint64_t *version) {
+  long size;
+  char *content = read_whole_file(path, &size);
+
+  if (content == NULL) {
+    return FALSE;
+  }
+
+  *version = hash_bytes(content, size, 0);
+  free(content);
+  return TRUE;
+}
+
 static int parse_header(char **regexPtr) {
     if (**regexPtr != '$') {
     fatal_error("Malformed regex spec line. Each line must specify a non-terminal\n\t%s",
@@ -109,33 +1215,43 @@ static int parse_header(char **regexPtr) {
   memcpy(nontermName, nontermNameStart, nontermNameSize);
   nontermName[nontermNameSize] = '\0';
 
-  int nontermIdx = -1;
+  // check if the non-term was encountered before, only the current
+  // module's forward references can still be incomplete
+  int nontermIdx = find_visible_nonterm(nontermName, nontermNameSize);
 
-  // check if the non-term was encountered before
-  for (int i=0 ; i<currentNonterm ; i++) {
-    if (strcmp(nontermName, nonterms[i].name) == 0) {
-      if (nonterms[i].complete) {
-        fatal_error("Re-definition of a non-terminal: %s\n", nontermName);
-      } else {
-        nontermIdx = i;
-        break;
-      }
-    }
+  if (nontermIdx != -1 && nonterms[nontermIdx].complete) {
+    fatal_error("Re-definition of a non-terminal: %s\n", nontermName);
   }
 
   if (nontermIdx == -1) {
     nontermIdx = currentNonterm++;
     assert(currentNonterm < MAX_NONTERMS && "Exceeded maximum number"
            " of non-terminals!\n");
+    nontermModules[nontermIdx] = currentModule;
   }
 
   strcpy(nonterms[nontermIdx].name, nontermName);
   nonterms[nontermIdx].idx = nontermIdx;
+  nonterms[nontermIdx].nextMode = NO_MODE;
+  nonterms[nontermIdx].trailTag = NO_TAG;
 
   while (isspace(**regexPtr)) {
     moveRegexPtr(*regexPtr);
   }
 
+  while (**regexPtr == '[' || **regexPtr == '<') {
+    if (**regexPtr == '<') {
+      moveRegexPtr(*regexPtr);
+      nonterms[nontermIdx].mode = parse_mode(regexPtr, '>');
+    } else {
+      parse_annotation(regexPtr, nontermIdx);
+    }
+
+    while (isspace(**regexPtr)) {
+      moveRegexPtr(*regexPtr);
+    }
+  }
+
   if (**regexPtr != ':' || *moveRegexPtr(*regexPtr) != '=') {
     fatal_error("Missing definition of a non-termianl\n");
   }
@@ -153,13 +1269,292 @@ static int parse_header(char **regexPtr) {
   return nontermIdx;
 }
 
+/// Copies the action block at the end of the line, if any, to the action
+/// pool and ends the line right before it. Returns the copied code or
+/// NULL.
+static char *parse_action(char *regex) {
+  char *start = strstr(regex, "@{");
+
+  // @{ can't be part of an operand, it must start one
+  while (start != NULL && start != regex && !isspace(*(start-1))) {
+    start = strstr(start+1, "@{");
+  }
+
+  if (start == NULL) {
+    return NULL;
+  }
+
+  char *end = NULL;
+
+  for (char *close=strstr(start+2, "@}") ; close != NULL ;
+       close=strstr(close+2, "@}")) {
+    end = close;
+  }
+
+  if (end == NULL) {
+    currentColumn = start - regex;
+    fatal_error("Missing @} at the end of an action\n");
+  }
+
+  int size = end - (start+2);
+  assert(currentActionStart+size+1-actionPool <= MAX_TOTAL_ACTION_LEN
+         && "Action pool is out of memory!\n");
+  char *action = currentActionStart;
+  memcpy(action, start+2, size);
+  action[size] = '\0';
+  currentActionStart += size + 1;
+
+  start[0] = '\n';
+  start[1] = '\0';
+  return action;
+}
+
+/// Parses an annotation of a non-terminal: [skip], [nocase],
+/// [begin:NAME], or the name of a decoder, e.g. [decimal], see
+/// DecoderType
+static void parse_annotation(char **regexPtr, int nontermIdx) {
+  static const char *decoderNames[] = {
+    [DECIMAL_DECODER] = "decimal",
+    [HEX_DECODER] = "hex",
+    [CHAR_DECODER] = "char",
+    [STRING_DECODER] = "string",
+    [INTERN_DECODER] = "intern"
+  };
+
+  char *nameStart = moveRegexPtr(*regexPtr);
+
+  if (strncmp(nameStart, "begin:", 6) == 0) {
+    for (int i=0 ; i<6 ; i++) {
+      moveRegexPtr(*regexPtr);
+    }
+
+    nonterms[nontermIdx].nextMode = parse_mode(regexPtr, ']');
+    return;
+  }
+
+  while (**regexPtr != '\0' && **regexPtr != ']' && !isspace(**regexPtr)) {
+    moveRegexPtr(*regexPtr);
+  }
+
+  if (**regexPtr != ']') {
+    fatal_error("Missing ] after an annotation\n");
+  }
+
+  int nameSize = *regexPtr - nameStart;
+  moveRegexPtr(*regexPtr);
+
+  if (nameSize == 4 && memcmp(nameStart, "skip", 4) == 0) {
+    nonterms[nontermIdx].skip = TRUE;
+    return;
+  }
+
+  if (nameSize == 6 && memcmp(nameStart, "nocase", 6) == 0) {
+    nonterms[nontermIdx].nocase = TRUE;
+    return;
+  }
+
+  for (int d=DECIMAL_DECODER ; d<=INTERN_DECODER ; d++) {
+    if ((int)strlen(decoderNames[d]) == nameSize
+        && memcmp(decoderNames[d], nameStart, nameSize) == 0) {
+      nonterms[nontermIdx].decoder = d;
+      return;
+    }
+  }
+
+  fatal_error("Unknown annotation: %.*s\n", nameSize, nameStart);
+}
+
+/// Parses a mode name ending with the given character and returns the
+/// mode's index, adding the mode if it's new
+static int parse_mode(char **regexPtr, char end) {
+  char *nameStart = *regexPtr;
+
+  while (**regexPtr != '\0' && **regexPtr != end && !isspace(**regexPtr)) {
+    moveRegexPtr(*regexPtr);
+  }
+
+  int nameSize = *regexPtr - nameStart;
+
+  if (**regexPtr != end || nameSize == 0) {
+    fatal_error("Malformed mode name, expected a name followed by %c\n", end);
+  }
+
+  moveRegexPtr(*regexPtr);
+  return intern_mode(nameStart, nameSize);
+}
+
+/// Returns the index of the mode with the given name, adding the mode if
+/// it's new
+static int intern_mode(char *name, int nameSize) {
+  assert(nameSize < MAX_NONTERM_NAME && "Mode name is too long!\n");
+
+  for (int i=0 ; i<numModes ; i++) {
+    if (memcmp(modes[i].name, name, nameSize) == 0
+        && modes[i].name[nameSize] == '\0') {
+      return i;
+    }
+  }
+
+  assert(numModes < MAX_MODES && "Exceeded maximum number of modes!\n");
+  memcpy(modes[numModes].name, name, nameSize);
+  modes[numModes].name[nameSize] = '\0';
+  return numModes++;
+}
+
+/// Returns the index of the tag with the given name, adding the tag if
+/// it's new. The tag counts as one of the current module's.
+static int intern_tag(char *name, int nameSize) {
+  assert(nameSize < MAX_NONTERM_NAME && "Tag name is too long!\n");
+
+  for (int i=0 ; i<numTags ; i++) {
+    if (memcmp(tags[i].name, name, nameSize) == 0
+        && tags[i].name[nameSize] == '\0') {
+      modules[currentModule].tags |= (uint32_t)1 << i;
+      return i;
+    }
+  }
+
+  assert(numTags < MAX_TAGS && "Exceeded maximum number of tags!\n");
+  memcpy(tags[numTags].name, name, nameSize);
+  tags[numTags].name[nameSize] = '\0';
+  modules[currentModule].tags |= (uint32_t)1 << numTags;
+  return numTags++;
+}
+
+/// Parses @u{...} or @p{...} (see CODE_POINTS) into a new code point set
+/// and returns its index
+static PoolOffset parse_code_points(char *operand, int operandSize) {
+  bool categories = operand[1] == 'p';
+  char *item = operand + 3;
+  char *end = operand + operandSize - 1;
+
+  if (*end != '}') {
+    fatal_error("Missing } after code points\n");
+  }
+
+  assert(numCodePointSets < MAX_CODE_POINT_SETS && "Exceeded maximum number"
+         " of code point sets!\n");
+  CodePointSetPtr set = codePointSets + numCodePointSets;
+  set->first = currentCodePointRange;
+  int numRanges = 0;
+
+  while (item < end) {
+    char *itemEnd = item;
+
+    while (itemEnd < end && *itemEnd != ',') {
+      itemEnd++;
+    }
+
+    CodePointRangePtr ranges = codePointRanges + set->first + numRanges;
+    int maxRanges = MAX_CODE_POINT_RANGES - set->first - numRanges;
+
+    if (categories) {
+      int numAdded = get_category_ranges(item, itemEnd - item, ranges,
+                                         maxRanges);
+
+      if (numAdded == -1) {
+        fatal_error("Unknown Unicode category: %.*s\n", (int)(itemEnd - item),
+                    item);
+      } else if (numAdded == TOO_MANY_RANGES) {
+        fatal_error("The code point sets need more than %d ranges\n",
+                    MAX_CODE_POINT_RANGES);
+      }
+
+      numRanges += numAdded;
+    } else {
+      char *numEnd;
+
+      if (maxRanges == 0) {
+        fatal_error("The code point sets need more than %d ranges\n",
+                    MAX_CODE_POINT_RANGES);
+      }
+
+      ranges->first = strtoul(item, &numEnd, 16);
+      ranges->last = ranges->first;
+
+      if (numEnd < itemEnd && *numEnd == '-') {
+        ranges->last = strtoul(numEnd + 1, &numEnd, 16);
+      }
+
+      if (numEnd != itemEnd || ranges->first > ranges->last
+          || ranges->last > MAX_CODE_POINT) {
+        fatal_error("Malformed code point range: %.*s\n",
+                    (int)(itemEnd - item), item);
+      }
+
+      numRanges++;
+    }
+
+    item = itemEnd + 1;
+  }
+
+  set->numRanges = normalize_code_point_ranges(codePointRanges + set->first,
+                                               numRanges,
+                                               MAX_CODE_POINT_RANGES
+                                               - set->first);
+
+  if (set->numRanges == TOO_MANY_RANGES) {
+    fatal_error("The code point sets need more than %d ranges\n",
+                MAX_CODE_POINT_RANGES);
+  } else if (set->numRanges == 0) {
+    fatal_error("Empty set of code points\n");
+  }
+
+  currentCodePointRange += set->numRanges;
+  return numCodePointSets++;
+}
+
+/// Loads the dictionary of a @w{path} operand (see DICTIONARY) and
+/// returns its index
+static PoolOffset parse_dictionary(char *operand, int operandSize) {
+  char path[MAX_REGEX_LEN];
+
+  if (operand[operandSize-1] != '}' || operandSize == 4) {
+    fatal_error("Malformed dictionary: %.*s\n", operandSize, operand);
+  }
+
+  memcpy(path, operand + 3, operandSize - 4);
+  path[operandSize-4] = '\0';
+  add_spec_file(path);
+  FILE *in = fopen(path, "r");
+
+  if (in == NULL) {
+    fatal_error("Can't open dictionary %s\n", path);
+  }
+
+  PoolOffset dictIdx;
+  long line;
+  DictionaryStatus status = load_dictionary(in, &dictIdx, &line);
+  fclose(in);
+
+  if (status == WORDS_OUT_OF_ORDER) {
+    fatal_error("Word on line %ld of %s is out of order, the words must be"
+                " sorted by bytes\n", line, path);
+  } else if (status == WORD_TOO_LONG) {
+    fatal_error("Word on line %ld of %s is longer than %d bytes\n", line,
+                path, MAX_WORD_LEN);
+  }
+
+  uint64_t version;
+
+  // a module's artifact doesn't store the words, only which ones it saw
+  if (moduleCacheDir != NULL && currentModule != MAIN_MODULE
+      && file_version(path, &version)) {
+    add_dependency(path, version, TRUE);
+  }
+
+  return dictIdx;
+}
+
 static void parse_body(char **regexPtr, int nontermIdx) {
   PoolOffset op = -1;
   assert(freeExprIdx < MAX_NESTED_EXPRS && "Expression pool is "
          "out of memory!\n");
   Expression *currentExpr = exprPool + freeExprIdx;
   PoolOffset currentExprIdx = freeExprIdx;
+  PoolOffset firstExprIdx = freeExprIdx;
   nonterms[nontermIdx].expr = freeExprIdx;
+  bodyNontermIdx = nontermIdx;
   freeExprIdx++;
   Expression *prevExpr = currentExpr;
   OperandType opType = NOTHING;
@@ -190,8 +1585,14 @@ static void parse_body(char **regexPtr, int nontermIdx) {
       newExpr->op1 = currentExprIdx;
       newExpr->op1Type = NESTED_EXPRESSION;
 
-      prevExpr->op2 = freeExprIdx;
-      prevExpr->op2Type = NESTED_EXPRESSION;
+      // the rule's first operand has no prevExpr to hang the new
+      // expression on, it becomes the rule's expression instead
+      if (currentExprIdx == nonterms[nontermIdx].expr) {
+        nonterms[nontermIdx].expr = freeExprIdx;
+      } else {
+        prevExpr->op2 = freeExprIdx;
+        prevExpr->op2Type = NESTED_EXPRESSION;
+      }
 
       currentExpr = newExpr;
       freeExprIdx++;
@@ -217,6 +1618,18 @@ static void parse_body(char **regexPtr, int nontermIdx) {
   prevExpr->op2 = -1;
   prevExpr->op2Type = NOTHING;
 
+  // the rule's expressions are replaced by the shared ones, which only
+  // adds the ones not seen before back to the pool
+  int numRuleExprs = freeExprIdx - firstExprIdx;
+
+  if (numRuleExprs > 0) {
+    memcpy(ruleExprs, exprPool + firstExprIdx,
+           numRuleExprs*sizeof(Expression));
+    freeExprIdx = firstExprIdx;
+    nonterms[nontermIdx].expr = share_expr(nonterms[nontermIdx].expr,
+                                           firstExprIdx);
+  }
+
 /*   log("+++++++++++++++++++++++++\n"); */
 /*   log("%s:\n", nonterms[nontermIdx].name); */
 /*   log_expr(nonterms[nontermIdx].expr); */
@@ -251,43 +1664,85 @@ static OperandType parse_operand(char **regexPtr, PoolOffset *res) {
   }
 
   int operandNameSize = *regexPtr - operandStart;
+  bool complement = operandNameSize > 1 && operandStart[0] == '~'
+    && operandStart[1] == '$';
+
+  if (complement) {
+    operandStart++;
+    operandNameSize--;
+  }
 
   if (*operandStart == '$') {
     if (operandNameSize == 1) {
       fatal_error("Empty non-terminal name\n");
     }
 
-    int opIdx = -1;
-
-    for (int i=0 ; i<currentNonterm ; i++) {
-      if (memcmp(nonterms[i].name, operandStart, operandNameSize) == 0) {
-        opIdx = i;
-        break;
-      }
-    }
+    int opIdx = find_visible_nonterm(operandStart, operandNameSize);
 
     if (opIdx == -1) {
       opIdx = currentNonterm++;
       assert(currentNonterm < MAX_NONTERMS && "Exceeded maximum number"
              " of non-terminals!\n");
+      nontermModules[opIdx] = currentModule;
       memcpy(nonterms[opIdx].name, operandStart, operandNameSize);
       nonterms[opIdx].name[operandNameSize] = '\0';
       nonterms[opIdx].complete = FALSE;
       nonterms[opIdx].idx = opIdx;
+      nonterms[opIdx].nextMode = NO_MODE;
+      nonterms[opIdx].trailTag = NO_TAG;
     }
 
     *res = opIdx;
-    return NON_TERMINAL;
+    return complement ? COMPLEMENT : NON_TERMINAL;
+  } else if (operandNameSize > 1 && operandStart[0] == '@'
+             && operandStart[1] == '#') {
+    if (operandNameSize == 2) {
+      fatal_error("Empty tag name\n");
+    }
+
+    *res = intern_tag(operandStart, operandNameSize);
+    return TAG;
+  } else if (operandNameSize > 3 && operandStart[0] == '@'
+             && (operandStart[1] == 'u' || operandStart[1] == 'p')
+             && operandStart[2] == '{') {
+    *res = parse_code_points(operandStart, operandNameSize);
+    return CODE_POINTS;
+  } else if (operandNameSize > 3 && operandStart[0] == '@'
+             && operandStart[1] == 'w' && operandStart[2] == '{') {
+    *res = parse_dictionary(operandStart, operandNameSize);
+    return DICTIONARY;
+  } else if (operandNameSize == 2 && operandStart[0] == '@'
+             && operandStart[1] == '/') {
+    NonTerminalPtr nonterm = nonterms + bodyNontermIdx;
+
+    if (nonterm->trailTag != NO_TAG) {
+      fatal_error("A rule can only have one trailing context\n");
+    }
+
+    char name[MAX_NONTERM_NAME];
+    int nameSize = snprintf(name, MAX_NONTERM_NAME, "@/%s", nonterm->name);
+    assert(nameSize < MAX_NONTERM_NAME && "Tag name is too long!\n");
+    nonterm->trailTag = intern_tag(name, nameSize);
+    tags[nonterm->trailTag].trailing = TRUE;
+    *res = nonterm->trailTag;
+    return TAG;
   } else {
+    OperandType type = nonterms[bodyNontermIdx].nocase ? CASELESS_TERMINAL
+      : TERMINAL;
+
+    if (operandNameSize > 2 && operandStart[0] == '@'
+        && operandStart[1] == '^') {
+      type = CASELESS_TERMINAL;
+      operandStart += 2;
+      operandNameSize -= 2;
+    }
+
     assert(currentTermStart+operandNameSize-termPool <= MAX_TOTAL_TERM_LEN
            && "Terminal pool is out of memory!\n");
     int size = memcpy2(currentTermStart, operandStart, operandNameSize,
-                       '@', "_@|*$", " @|*$");
-    currentTermStart[size] = '\0';
-    currentTermStart += (operandNameSize + 1);
-
-    *res = currentTermStart - (operandNameSize+1) - termPool;
-    return TERMINAL;
+                       '@', "_@|*$tn&~", " @|*$\t\n&~");
+    *res = intern_terminal(currentTermStart, size);
+    return type;
   }
 }
 
@@ -306,6 +1761,11 @@ static OperatorType parse_operator(char **regexPtr) {
   } else if (**regexPtr == '*') {
     opCode = ZERO_OR_MORE;
     moveRegexPtr(*regexPtr);
+  } else if (**regexPtr == '&' && (isspace(*(*regexPtr+1))
+                                   || *(*regexPtr+1) == '\0')) {
+    // a & glued to other characters is a literal, e.g. &&
+    opCode = INTERSECT;
+    moveRegexPtr(*regexPtr);
   } else {
     // we currently hit the next operand, this must be an AND
     // don't move to next character
@@ -342,6 +1802,7 @@ static int memcpy2(char *dest, char *src, int numBytes, char escapeChar,
       }
 
       src++;
+      numBytes--;
       char *pos = strchr(toEscape, *src);
 
       if (pos == NULL) {
@@ -354,9 +1815,11 @@ static int memcpy2(char *dest, char *src, int numBytes, char escapeChar,
       }
 
       copied--;
+    } else {
+      c = *src;
     }
 
-    *(char*)dest = *(char*)src;
+    *(char*)dest = (char)c;
     dest++;
     src++;
   }
@@ -380,9 +1843,24 @@ static void log_expr(PoolOffset exprIdx) {
   case NON_TERMINAL:
     log("%s", nonterms[expr->op1].name);
     break;
+  case COMPLEMENT:
+    log("~%s", nonterms[expr->op1].name);
+    break;
   case TERMINAL:
     log("%s", (termPool + expr->op1));
     break;
+  case CASELESS_TERMINAL:
+    log("@^%s", (termPool + expr->op1));
+    break;
+  case TAG:
+    log("%s", tags[expr->op1].name);
+    break;
+  case CODE_POINTS:
+    log("@u{set %d}", expr->op1);
+    break;
+  case DICTIONARY:
+    log("@w{dictionary %d}", expr->op1);
+    break;
   case NOTHING:
     log("");
     break;
@@ -401,6 +1879,12 @@ static void log_expr(PoolOffset exprIdx) {
   case ZERO_OR_MORE:
     log("*");
     break;
+  case ONE_OR_MORE:
+    log("+");
+    break;
+  case INTERSECT:
+    log(" && ");
+    break;
   }
 
   switch (expr->op2Type) {
@@ -410,9 +1894,24 @@ static void log_expr(PoolOffset exprIdx) {
   case NON_TERMINAL:
     log("%s", nonterms[expr->op2].name);
     break;
+  case COMPLEMENT:
+    log("~%s", nonterms[expr->op2].name);
+    break;
   case TERMINAL:
     log("%s", (termPool + expr->op2));
     break;
+  case CASELESS_TERMINAL:
+    log("@^%s", (termPool + expr->op2));
+    break;
+  case TAG:
+    log("%s", tags[expr->op2].name);
+    break;
+  case CODE_POINTS:
+    log("@u{set %d}", expr->op2);
+    break;
+  case DICTIONARY:
+    log("@w{dictionary %d}", expr->op2);
+    break;
   case NOTHING:
     log("");
     break;
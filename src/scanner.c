@@ -0,0 +1,466 @@
+#include "../include/scanner.h"
+#include "../include/hash.h"
+#include "../include/decode.h"
+
+#define INITIAL_TOKEN_BUFFER_CAPACITY 1024
+#define INITIAL_STRINGS_CAPACITY      4096
+
+typedef enum {
+  EMIT_TOKENS,
+  // with tag positions and/or decoded values, see TokenBuffer
+  EMIT_ANNOTATED_TOKENS,
+  COUNT_TOKENS
+} ScanMode;
+
+static void init_scanner_mode(ScannerPtr scanner, int mode, DFAPtr dfa);
+static bool is_final_state(DFAStatePtr state);
+static void set_tags(int *regs, uint32_t tags, int position);
+static void decode_token_value(TokenBufferPtr tokens, const char *lexeme,
+                               int length, DecoderType decoder);
+static void write_token_value(FILE *out, TokenBufferPtr tokens,
+                              TokenValuePtr value);
+static long scan(ScannerPtr scanner, const char *buf, long size,
+                 long baseOffset, ScanMode mode, bool trackTags,
+                 TokenBufferPtr tokens, long *counts);
+
+void init_scanner(ScannerPtr scanner, DFAStatePtr dfaStateTable, DFAPtr dfas,
+                  int numModes, NonTerminalPtr nontermTable,
+                  int nontermTableSize) {
+  scanner->states = dfaStateTable;
+  scanner->start = dfas[0].start;
+  scanner->numStates = 0;
+  scanner->numModes = numModes;
+  get_modes(&scanner->modeTable);
+  scanner->nontermTable = nontermTable;
+  scanner->nontermTableSize = nontermTableSize;
+  scanner->numTags = get_tags(&scanner->tagTable);
+  scanner->tagOps = get_tag_ops_table();
+  scanner->hasTrailingContext = FALSE;
+
+  for (int i=0 ; i<nontermTableSize ; i++) {
+    scanner->skipped[i] = nontermTable[i].skip;
+    scanner->nextMode[i] = nontermTable[i].nextMode;
+    scanner->trailTag[i] = nontermTable[i].trailTag;
+    scanner->hasTrailingContext |= nontermTable[i].trailTag != NO_TAG;
+  }
+
+  for (int m=0 ; m<numModes ; m++) {
+    assert(dfas[m].start == scanner->start + scanner->numStates
+           && "The DFAs of the modes must be contiguous!\n");
+    scanner->numStates += dfas[m].numStates;
+    init_scanner_mode(scanner, m, dfas + m);
+  }
+
+  PoolOffset end = scanner->start + scanner->numStates;
+
+  for (int c=0 ; c<ALPHABET_SIZE ; c++) {
+    scanner->separators[c] = TRUE;
+  }
+
+  // state by state, reading the table in order, a DFA may have many
+  // thousands of states (see load_dictionary)
+  for (int s=scanner->start ; s<end ; s++) {
+    for (int c=0 ; c<ALPHABET_SIZE ; c++) {
+      if (dfaStateTable[s].transitions[c] != DEAD_STATE) {
+        scanner->separators[c] = FALSE;
+      }
+    }
+  }
+
+  // states are hashed relative to the start state so that the same DFA
+  // gets the same hash wherever it's placed in the pool
+  uint64_t hash = 0;
+
+  for (int s=scanner->start ; s<end ; s++) {
+    DFAState state = dfaStateTable[s];
+
+    for (int c=0 ; c<ALPHABET_SIZE ; c++) {
+      if (state.transitions[c] != DEAD_STATE) {
+        state.transitions[c] -= scanner->start;
+      }
+    }
+
+    state.tagOps = NO_TAG_OPS;
+    hash = hash_bytes(&state, sizeof(DFAState), hash);
+
+    if (dfaStateTable[s].tagOps != NO_TAG_OPS) {
+      hash = hash_bytes(scanner->tagOps[dfaStateTable[s].tagOps],
+                        sizeof(TagOpsRow), hash);
+    }
+  }
+
+  for (int m=0 ; m<numModes ; m++) {
+    PoolOffset start = scanner->modes[m].start - scanner->start;
+    hash = hash_bytes(&start, sizeof(PoolOffset), hash);
+    hash = hash_bytes(&scanner->modes[m].startTags, sizeof(uint32_t), hash);
+  }
+
+  for (int i=0 ; i<scanner->numTags ; i++) {
+    hash = hash_bytes(scanner->tagTable[i].name,
+                      strlen(scanner->tagTable[i].name), hash);
+  }
+
+  for (int i=0 ; i<nontermTableSize ; i++) {
+    hash = hash_bytes(nontermTable[i].name, strlen(nontermTable[i].name),
+                      hash);
+    hash = hash_bytes(&scanner->skipped[i], sizeof(bool), hash);
+    hash = hash_bytes(&scanner->nextMode[i], sizeof(int), hash);
+    hash = hash_bytes(&scanner->trailTag[i], sizeof(int), hash);
+  }
+
+  scanner->specHash = hash;
+}
+
+/// Fills the dispatch table of a mode. White space is only skipped
+/// implicitly in the initial mode, other modes (e.g. the inside of a
+/// string) usually need to see it.
+static void init_scanner_mode(ScannerPtr scanner, int mode, DFAPtr dfa) {
+  DFAStatePtr dfaStateTable = scanner->states;
+  ScannerModePtr scannerMode = scanner->modes + mode;
+  scannerMode->start = dfa->start;
+  scannerMode->startTags = dfa->startTags;
+
+  for (int c=0 ; c<ALPHABET_SIZE ; c++) {
+    DispatchEntryPtr entry = scannerMode->dispatch + c;
+    PoolOffset target = dfaStateTable[dfa->start].transitions[c];
+    PoolOffset startTagOps = dfaStateTable[dfa->start].tagOps;
+    entry->state = target;
+    entry->token = NO_TOKEN;
+    entry->tagOps = startTagOps == NO_TAG_OPS ? 0
+      : scanner->tagOps[startTagOps][c];
+
+    if (isspace(c) && mode == INITIAL_MODE) {
+      entry->type = DISPATCH_SKIP;
+    } else if (target == DEAD_STATE) {
+      entry->type = DISPATCH_UNMATCHED;
+    } else {
+      entry->token = dfaStateTable[target].token;
+      entry->type = DISPATCH_ENTER;
+
+      if (entry->token != NO_TOKEN && is_final_state(dfaStateTable + target)) {
+        // a skipped token that switches modes still needs the scanning
+        // loop to do the switch
+        bool skip = scanner->skipped[entry->token]
+          && scanner->nextMode[entry->token] == NO_MODE;
+        entry->type = skip ? DISPATCH_SKIP : DISPATCH_SINGLE_BYTE;
+      }
+    }
+  }
+}
+
+long scan_buffer(ScannerPtr scanner, const char *buf, long size,
+                 long baseOffset, TokenBufferPtr tokens) {
+  if (tokens->numTags > 0 || tokens->decodeValues) {
+    assert((tokens->numTags == 0 || tokens->numTags == scanner->numTags)
+           && "Invalid token buffer!\n");
+    return scan(scanner, buf, size, baseOffset, EMIT_ANNOTATED_TOKENS, TRUE,
+                tokens, NULL);
+  }
+
+  if (scanner->hasTrailingContext) {
+    return scan(scanner, buf, size, baseOffset, EMIT_TOKENS, TRUE, tokens,
+                NULL);
+  }
+
+  return scan(scanner, buf, size, baseOffset, EMIT_TOKENS, FALSE, tokens,
+              NULL);
+}
+
+long count_buffer(ScannerPtr scanner, const char *buf, long size,
+                  long *counts) {
+  if (scanner->hasTrailingContext) {
+    return scan(scanner, buf, size, 0, COUNT_TOKENS, TRUE, NULL, counts);
+  }
+
+  return scan(scanner, buf, size, 0, COUNT_TOKENS, FALSE, NULL, counts);
+}
+
+/// The scanning loop shared by all scan modes. It's always inlined with
+/// a constant mode, which lets the compiler drop the code of the other
+/// modes from the loop, e.g. counting never touches a TokenBuffer.
+/// Likewise, the tag registers are only maintained if trackTags is TRUE,
+/// i.e. if tags are captured or the spec has trailing contexts.
+static inline __attribute__((always_inline))
+long scan(ScannerPtr scanner, const char *buf, long size, long baseOffset,
+          ScanMode mode, bool trackTags, TokenBufferPtr tokens,
+          long *counts) {
+  DFAStatePtr states = scanner->states;
+  ScannerModePtr scannerMode = scanner->modes + INITIAL_MODE;
+  long numUnmatched = 0;
+  long pos = 0;
+  // the tag registers while matching a token and their values at the
+  // last accepting state
+  int regs[MAX_TAGS];
+  int lastRegs[MAX_TAGS];
+  int numRegs = trackTags ? scanner->numTags : 0;
+
+  while (pos < size) {
+    DispatchEntryPtr entry = scannerMode->dispatch + (unsigned char)buf[pos];
+
+    if (entry->type == DISPATCH_SKIP) {
+      pos++;
+      continue;
+    }
+
+    // for single byte tokens and unmatched bytes, the token is already
+    // known and the DFA loop is skipped
+    PoolOffset state = entry->state;
+    int lastToken = entry->token;
+    long lastEnd = pos + 1;
+    DecoderType lastDecoder = NO_DECODER;
+
+    if (trackTags) {
+      for (int t=0 ; t<numRegs ; t++) {
+        regs[t] = -1;
+      }
+
+      set_tags(regs, scannerMode->startTags, 0);
+      set_tags(regs, entry->tagOps, 1);
+      memcpy(lastRegs, regs, numRegs*sizeof(int));
+    }
+
+    if (mode == EMIT_ANNOTATED_TOKENS && state != DEAD_STATE) {
+      lastDecoder = states[state].decoder;
+    }
+
+    if (entry->type == DISPATCH_ENTER) {
+      for (long p=pos+1 ; p<size ; p++) {
+        unsigned char c = buf[p];
+
+        if (trackTags && states[state].tagOps != NO_TAG_OPS) {
+          set_tags(regs, scanner->tagOps[states[state].tagOps][c],
+                   p + 1 - pos);
+        }
+
+        state = states[state].transitions[c];
+
+        if (state == DEAD_STATE) {
+          break;
+        }
+
+        if (states[state].token != NO_TOKEN) {
+          lastToken = states[state].token;
+          lastEnd = p + 1;
+
+          if (trackTags) {
+            memcpy(lastRegs, regs, numRegs*sizeof(int));
+          }
+
+          if (mode == EMIT_ANNOTATED_TOKENS) {
+            lastDecoder = states[state].decoder;
+          }
+        }
+      }
+    }
+
+    if (lastToken == NO_TOKEN) {
+      numUnmatched++;
+    } else {
+      // the trailing context is only looked at, the token ends before it.
+      // A token is never cut to nothing, the scanner has to make progress.
+      if (trackTags && scanner->trailTag[lastToken] != NO_TAG
+          && lastRegs[scanner->trailTag[lastToken]] > 0) {
+        lastEnd = pos + lastRegs[scanner->trailTag[lastToken]];
+      }
+
+      if (scanner->nextMode[lastToken] != NO_MODE) {
+        scannerMode = scanner->modes + scanner->nextMode[lastToken];
+      }
+
+      if (scanner->skipped[lastToken]) {
+        pos = lastEnd;
+        continue;
+      }
+    }
+
+    if (mode == EMIT_TOKENS) {
+      append_token(tokens, baseOffset + pos, lastEnd - pos, lastToken);
+    } else if (mode == EMIT_ANNOTATED_TOKENS) {
+      append_token(tokens, baseOffset + pos, lastEnd - pos, lastToken);
+
+      // an unmatched byte has no tags even if the DFA crossed some
+      // before dying
+      for (int t=0 ; t<tokens->numTags ; t++) {
+        tokens->tags[(tokens->size-1)*tokens->numTags + t] =
+          lastToken == NO_TOKEN ? -1 : lastRegs[t];
+      }
+
+      // the lexeme was just scanned, hence, it's decoded while it's
+      // still in the cache rather than in a second pass over the input
+      if (tokens->decodeValues) {
+        decode_token_value(tokens, buf + pos, lastEnd - pos,
+                           lastToken == NO_TOKEN ? NO_DECODER : lastDecoder);
+      }
+    } else {
+      counts[lastToken+1]++;
+    }
+
+    pos = lastEnd;
+  }
+
+  return numUnmatched;
+}
+
+void write_tokens_text(FILE *out, ScannerPtr scanner, TokenBufferPtr tokens) {
+  for (long i=0 ; i<tokens->size ; i++) {
+    TokenPtr token = tokens->tokens + i;
+    char *name = token->kind == NO_TOKEN ? "<unmatched>"
+      : scanner->nontermTable[token->kind].name;
+    fprintf(out, "%ld %d %s", token->offset, token->length, name);
+
+    for (int t=0 ; t<tokens->numTags ; t++) {
+      int position = tokens->tags[i*tokens->numTags + t];
+
+      if (position != -1 && !scanner->tagTable[t].trailing) {
+        fprintf(out, " %s=%d", scanner->tagTable[t].name + 2, position);
+      }
+    }
+
+    if (tokens->decodeValues) {
+      write_token_value(out, tokens, tokens->values + i);
+    }
+
+    fputc('\n', out);
+  }
+}
+
+void init_token_buffer(TokenBufferPtr tokens) {
+  tokens->tokens = NULL;
+  tokens->size = 0;
+  tokens->capacity = 0;
+  tokens->tags = NULL;
+  tokens->numTags = 0;
+  tokens->values = NULL;
+  tokens->decodeValues = FALSE;
+  tokens->strings = NULL;
+  tokens->stringsSize = 0;
+  tokens->stringsCapacity = 0;
+  tokens->symbols = NULL;
+}
+
+void init_tagged_token_buffer(TokenBufferPtr tokens, int numTags) {
+  init_token_buffer(tokens);
+  tokens->numTags = numTags;
+}
+
+void free_token_buffer(TokenBufferPtr tokens) {
+  free(tokens->tokens);
+  free(tokens->tags);
+  free(tokens->values);
+  free(tokens->strings);
+  // the symbol table isn't owned by the buffer
+  init_token_buffer(tokens);
+}
+
+/// TRUE if no transition leaves the state
+static bool is_final_state(DFAStatePtr state) {
+  for (int c=0 ; c<ALPHABET_SIZE ; c++) {
+    if (state->transitions[c] != DEAD_STATE) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/// Stores position in the registers of the given tags
+static inline void set_tags(int *regs, uint32_t tags, int position) {
+  while (tags != 0) {
+    regs[__builtin_ctz(tags)] = position;
+    tags &= tags - 1;
+  }
+}
+
+/// Decodes the value of the last token appended to tokens. Decoded
+/// strings are stored back to back in tokens->strings.
+static void decode_token_value(TokenBufferPtr tokens, const char *lexeme,
+                               int length, DecoderType decoder) {
+  TokenValuePtr value = tokens->values + tokens->size - 1;
+  value->decoder = decoder;
+  value->value = 0;
+
+  switch (decoder) {
+  case NO_DECODER:
+    break;
+  case DECIMAL_DECODER:
+    value->value = (long)decode_decimal(lexeme, length);
+    break;
+  case HEX_DECODER:
+    value->value = (long)decode_hex(lexeme, length);
+    break;
+  case CHAR_DECODER:
+    value->value = decode_char(lexeme, length);
+    break;
+  case STRING_DECODER:
+    // decoding never makes a string longer, +1 for the NUL
+    while (tokens->stringsSize + length + 1 > tokens->stringsCapacity) {
+      tokens->stringsCapacity = tokens->stringsCapacity == 0
+        ? INITIAL_STRINGS_CAPACITY : 2 * tokens->stringsCapacity;
+      tokens->strings = realloc(tokens->strings, tokens->stringsCapacity);
+      assert(tokens->strings != NULL && "Token buffer ran out of memory!\n");
+    }
+
+    value->value = tokens->stringsSize;
+    tokens->stringsSize += decode_string(lexeme, length,
+                                         tokens->strings + value->value) + 1;
+    break;
+  case INTERN_DECODER:
+    assert(tokens->symbols != NULL && "Missing symbol table!\n");
+    value->value = intern_symbol(tokens->symbols, lexeme, length);
+    break;
+  }
+}
+
+/// Writes " value=..." for a decoded token, strings are written quoted
+/// with their non printable characters escaped
+static void write_token_value(FILE *out, TokenBufferPtr tokens,
+                              TokenValuePtr value) {
+  if (value->decoder == NO_DECODER) {
+    return;
+  }
+
+  if (value->decoder != STRING_DECODER) {
+    fprintf(out, " value=%ld", value->value);
+    return;
+  }
+
+  fputs(" value=\"", out);
+
+  for (char *c=tokens->strings + value->value ; *c != '\0' ; c++) {
+    if (*c == '"' || *c == '\\') {
+      fprintf(out, "\\%c", *c);
+    } else if (isprint((unsigned char)*c)) {
+      fputc(*c, out);
+    } else {
+      fprintf(out, "\\x%02x", (unsigned char)*c);
+    }
+  }
+
+  fputc('"', out);
+}
+
+void append_token(TokenBufferPtr tokens, long offset, int length, int kind) {
+  if (tokens->size == tokens->capacity) {
+    tokens->capacity = tokens->capacity == 0 ? INITIAL_TOKEN_BUFFER_CAPACITY
+      : 2 * tokens->capacity;
+    tokens->tokens = realloc(tokens->tokens, tokens->capacity*sizeof(Token));
+    assert(tokens->tokens != NULL && "Token buffer ran out of memory!\n");
+
+    if (tokens->numTags > 0) {
+      tokens->tags = realloc(tokens->tags,
+                             tokens->capacity*tokens->numTags*sizeof(int));
+      assert(tokens->tags != NULL && "Token buffer ran out of memory!\n");
+    }
+
+    if (tokens->decodeValues) {
+      tokens->values = realloc(tokens->values,
+                               tokens->capacity*sizeof(TokenValue));
+      assert(tokens->values != NULL && "Token buffer ran out of memory!\n");
+    }
+  }
+
+  TokenPtr token = tokens->tokens + tokens->size++;
+  token->offset = offset;
+  token->length = length;
+  token->kind = kind;
+}
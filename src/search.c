@@ -0,0 +1,393 @@
+#define _GNU_SOURCE
+#include "../include/search.h"
+#include "../include/hash.h"
+#include "../include/dictionary.h"
+
+/// What every string matched by an expression has in common. Computed
+/// bottom up over the expression tree, following the same structure
+/// build_regex_expr_nfa does.
+typedef struct LiteralInfo {
+  // matches the empty string
+  bool nullable;
+  // matches exactly one string, which is then prefix
+  bool exact;
+  bool firstBytes[ALPHABET_SIZE];
+  char prefix[MAX_PREFILTER_LEN];
+  int prefixLen;
+} LiteralInfo, *LiteralInfoPtr;
+
+static NonTerminalPtr nontermTable;
+static ExpressionPtr exprTable;
+static char *termTable;
+
+static void analyze_operand(PoolOffset operand, OperandType type,
+                            LiteralInfoPtr info);
+static void analyze_expr(PoolOffset exprIdx, LiteralInfoPtr info);
+static void analyze_terminal(char *terminal, bool caseless,
+                             LiteralInfoPtr info);
+static long next_candidate(SearcherPtr searcher, const char *buf, long size,
+                           long pos);
+static uint64_t *find_match_starts(SearcherPtr searcher, const char *buf,
+                                   long size);
+
+void init_searcher(SearcherPtr searcher, ScannerPtr scanner, int nontermIdx,
+                   ExpressionPtr _exprTable, char *_termTable,
+                   NFAStatePtr nfaStateTable, NFAEdgePtr nfaEdgeTable,
+                   NFAPtr nfaTable) {
+  nontermTable = scanner->nontermTable;
+  exprTable = _exprTable;
+  termTable = _termTable;
+
+  DFAStatePtr dfaStateTable = NULL;
+  DFAPtr dfaTable = NULL;
+  PoolOffset dfaIdx = build_dfa(nfaStateTable, nfaEdgeTable, nfaTable,
+                                get_non_terminal_nfa(nontermIdx),
+                                &dfaStateTable, &dfaTable);
+
+  searcher->start = dfaTable[dfaIdx].start;
+  searcher->reverseStart = -1;
+  PoolOffset reverseNFAIdx = build_reverse_nfa(get_non_terminal_nfa(nontermIdx),
+                                               MAX_REVERSE_NFA_STATES);
+
+  if (reverseNFAIdx != -1) {
+    // the reverse NFA's states may have moved the NFA pools
+    get_nfa_tables(&nfaStateTable, &nfaEdgeTable, &nfaTable);
+    PoolOffset reverseDFAIdx = build_dfa(nfaStateTable, nfaEdgeTable,
+                                         nfaTable, reverseNFAIdx,
+                                         &dfaStateTable, &dfaTable);
+    searcher->reverseStart = dfaTable[reverseDFAIdx].start;
+  }
+
+  // and the new DFAs' states may have moved the pools the scanner points
+  // into
+  scanner->states = dfaStateTable;
+  scanner->tagOps = get_tag_ops_table();
+  searcher->states = dfaStateTable;
+  searcher->nontermIdx = nontermIdx;
+  searcher->trailTag = scanner->trailTag[nontermIdx];
+  searcher->tagOps = scanner->tagOps;
+  searcher->specHash = hash_bytes(&nontermIdx, sizeof(int),
+                                  scanner->specHash);
+
+  LiteralInfo info;
+  analyze_operand(nontermIdx, NON_TERMINAL, &info);
+  memcpy(searcher->firstBytes, info.firstBytes, sizeof(info.firstBytes));
+  memcpy(searcher->prefix, info.prefix, info.prefixLen);
+  searcher->prefixLen = info.prefixLen;
+}
+
+long search_buffer(SearcherPtr searcher, const char *buf, long size,
+                   long baseOffset, TokenBufferPtr matches) {
+  DFAStatePtr states = searcher->states;
+  long numMatches = 0;
+  long first = next_candidate(searcher, buf, size, 0);
+  // bit i is set if a match starts at first + i, NULL if every candidate
+  // has to be tried
+  uint64_t *starts = NULL;
+
+  if (first < size && searcher->reverseStart != -1) {
+    starts = find_match_starts(searcher, buf + first, size - first);
+  }
+
+  for (long pos=first ; pos<size ; ) {
+    long i = pos - first;
+
+    if (starts != NULL && !(starts[i / 64] & (1ULL << i % 64))) {
+      pos = next_candidate(searcher, buf, size, pos + 1);
+      continue;
+    }
+
+    PoolOffset state = searcher->start;
+    long lastEnd = -1;
+    // where the trailing context starts, relative to pos, while matching
+    // and at the last accepting state
+    int trail = -1;
+    int lastTrail = -1;
+
+    for (long p=pos ; p<size ; p++) {
+      unsigned char c = buf[p];
+
+      if (searcher->trailTag != NO_TAG && states[state].tagOps != NO_TAG_OPS
+          && searcher->tagOps[states[state].tagOps][c]
+          & (1U << searcher->trailTag)) {
+        trail = p + 1 - pos;
+      }
+
+      state = states[state].transitions[c];
+
+      if (state == DEAD_STATE) {
+        break;
+      }
+
+      if (states[state].token != NO_TOKEN) {
+        lastEnd = p + 1;
+        lastTrail = trail;
+      }
+    }
+
+    if (lastEnd == -1) {
+      pos = next_candidate(searcher, buf, size, pos + 1);
+      continue;
+    }
+
+    // the trailing context is only looked at, as in scan_buffer a match
+    // is never cut to nothing
+    if (lastTrail > 0) {
+      lastEnd = pos + lastTrail;
+    }
+
+    append_token(matches, baseOffset + pos, lastEnd - pos,
+                 searcher->nontermIdx);
+    numMatches++;
+    pos = next_candidate(searcher, buf, size, lastEnd);
+  }
+
+  free(starts);
+  return numMatches;
+}
+
+/// Returns the first position from pos on a match may start at, or size
+/// if there's none. memchr and memmem are vectorized by the C library.
+static long next_candidate(SearcherPtr searcher, const char *buf, long size,
+                           long pos) {
+  if (pos >= size) {
+    return size;
+  }
+
+  if (searcher->prefixLen > 1) {
+    const char *candidate = memmem(buf + pos, size - pos, searcher->prefix,
+                                   searcher->prefixLen);
+    return candidate == NULL ? size : candidate - buf;
+  }
+
+  if (searcher->prefixLen == 1) {
+    const char *candidate = memchr(buf + pos, searcher->prefix[0],
+                                   size - pos);
+    return candidate == NULL ? size : candidate - buf;
+  }
+
+  while (pos < size && !searcher->firstBytes[(unsigned char)buf[pos]]) {
+    pos++;
+  }
+
+  return pos;
+}
+
+/// Runs the reverse DFA (see Searcher) over buf from its last byte to its
+/// first and returns a bit set of the positions a non-empty match starts
+/// at, which the caller frees. For a rule matching the empty string, the
+/// DFA accepts everywhere and every position is set. The DFA has no
+/// transitions on NUL bytes, which no match contains, and starts over
+/// after one.
+static uint64_t *find_match_starts(SearcherPtr searcher, const char *buf,
+                                   long size) {
+  DFAStatePtr states = searcher->states;
+  uint64_t *starts = calloc(size / 64 + 1, sizeof(uint64_t));
+  assert(starts != NULL && "Out of memory!\n");
+  PoolOffset state = searcher->reverseStart;
+
+  for (long i=size-1 ; i>=0 ; i--) {
+    state = states[state].transitions[(unsigned char)buf[i]];
+
+    if (state == DEAD_STATE) {
+      state = searcher->reverseStart;
+    } else if (states[state].token != NO_TOKEN) {
+      starts[i / 64] |= 1ULL << i % 64;
+    }
+  }
+
+  return starts;
+}
+
+static void analyze_operand(PoolOffset operand, OperandType type,
+                            LiteralInfoPtr info) {
+  switch (type) {
+  case NESTED_EXPRESSION:
+    analyze_expr(operand, info);
+    break;
+  case NON_TERMINAL:
+    // a linked non-terminal (see set_module_cache) has no expression
+    if (nontermTable[operand].expr != LINKED_EXPR) {
+      analyze_expr(nontermTable[operand].expr, info);
+      break;
+    }
+    // fall through
+  case COMPLEMENT:
+    // nothing is known about what a complement matches either
+    memset(info->firstBytes, TRUE, sizeof(info->firstBytes));
+    info->nullable = TRUE;
+    info->exact = FALSE;
+    info->prefixLen = 0;
+    break;
+  case TERMINAL:
+    analyze_terminal(termTable + operand, FALSE, info);
+    break;
+  case CASELESS_TERMINAL:
+    analyze_terminal(termTable + operand, TRUE, info);
+    break;
+  case CODE_POINTS: {
+    // a single code point, which starts with the lead byte of one of the
+    // UTF-8 sequences of the set
+    CodePointSetPtr sets;
+    CodePointRangePtr ranges;
+    get_code_point_sets(&sets, &ranges);
+    memset(info->firstBytes, 0, sizeof(info->firstBytes));
+
+    for (int i=0 ; i<sets[operand].numRanges ; i++) {
+      Utf8Sequence sequences[MAX_SEQUENCES_PER_RANGE];
+      int numSequences = split_utf8_sequences(ranges[sets[operand].first + i],
+                                              sequences);
+
+      for (int j=0 ; j<numSequences ; j++) {
+        for (int c=sequences[j].first[0] ; c<=sequences[j].last[0] ; c++) {
+          info->firstBytes[c] = TRUE;
+        }
+      }
+    }
+
+    info->nullable = FALSE;
+    info->exact = FALSE;
+    info->prefixLen = 0;
+    break;
+  }
+  case DICTIONARY: {
+    // the words start with the bytes leaving the root, and the empty
+    // word is never added
+    DictStatePtr dictStates;
+    DictEdgePtr dictEdges;
+    DictionaryPtr dicts;
+    get_dictionary_tables(&dictStates, &dictEdges, &dicts);
+    DictStatePtr root = dictStates + dicts[operand].root;
+    memset(info->firstBytes, 0, sizeof(info->firstBytes));
+
+    for (int e=0 ; e<root->numEdges ; e++) {
+      info->firstBytes[dictEdges[root->firstEdge + e].symbol] = TRUE;
+    }
+
+    info->nullable = FALSE;
+    info->exact = FALSE;
+    info->prefixLen = 0;
+    break;
+  }
+  case TAG:
+    // matches the empty string only
+    memset(info->firstBytes, 0, sizeof(info->firstBytes));
+    info->nullable = TRUE;
+    info->exact = TRUE;
+    info->prefixLen = 0;
+    break;
+  case NOTHING:
+    assert(FALSE && "Shouldn't have reached this!\n");
+  }
+}
+
+/// The prefix of a caseless terminal ends at its first letter, the bytes
+/// after it aren't known exactly
+static void analyze_terminal(char *terminal, bool caseless,
+                             LiteralInfoPtr info) {
+  int len = strlen(terminal);
+  int exactLen = len;
+
+  for (int i=0 ; caseless && i<len ; i++) {
+    if (isalpha((unsigned char)terminal[i])) {
+      exactLen = i;
+      break;
+    }
+  }
+
+  memset(info->firstBytes, 0, sizeof(info->firstBytes));
+
+  // an empty terminal (see factor_literal_alternations) matches only the
+  // empty string
+  if (len > 0) {
+    info->firstBytes[(unsigned char)terminal[0]] = TRUE;
+  }
+
+  if (len > 0 && caseless) {
+    info->firstBytes[tolower((unsigned char)terminal[0])] = TRUE;
+    info->firstBytes[toupper((unsigned char)terminal[0])] = TRUE;
+  }
+
+  info->nullable = len == 0;
+  info->exact = exactLen == len && len <= MAX_PREFILTER_LEN;
+  info->prefixLen = exactLen < MAX_PREFILTER_LEN ? exactLen
+    : MAX_PREFILTER_LEN;
+  memcpy(info->prefix, terminal, info->prefixLen);
+}
+
+static void analyze_expr(PoolOffset exprIdx, LiteralInfoPtr info) {
+  ExpressionPtr expr = exprTable + exprIdx;
+  LiteralInfo op2;
+  analyze_operand(expr->op1, expr->op1Type, info);
+
+  switch (expr->type) {
+  case NO_OP:
+    break;
+  case OR:
+    analyze_operand(expr->op2, expr->op2Type, &op2);
+
+    for (int c=0 ; c<ALPHABET_SIZE ; c++) {
+      info->firstBytes[c] |= op2.firstBytes[c];
+    }
+
+    // the longest common prefix of both alternatives
+    int common = 0;
+
+    while (common < info->prefixLen && common < op2.prefixLen
+           && info->prefix[common] == op2.prefix[common]) {
+      common++;
+    }
+
+    info->exact = info->exact && op2.exact && info->prefixLen == op2.prefixLen
+      && common == info->prefixLen;
+    info->nullable = info->nullable || op2.nullable;
+    info->prefixLen = info->nullable ? 0 : common;
+    break;
+  case AND:
+    analyze_operand(expr->op2, expr->op2Type, &op2);
+
+    if (info->nullable) {
+      for (int c=0 ; c<ALPHABET_SIZE ; c++) {
+        info->firstBytes[c] |= op2.firstBytes[c];
+      }
+    }
+
+    // the prefix only continues into op2 if op1 is a fixed string
+    if (info->exact) {
+      int room = MAX_PREFILTER_LEN - info->prefixLen;
+      int len = op2.prefixLen < room ? op2.prefixLen : room;
+      memcpy(info->prefix + info->prefixLen, op2.prefix, len);
+      info->prefixLen += len;
+      info->exact = op2.exact && len == op2.prefixLen;
+    }
+
+    info->nullable = info->nullable && op2.nullable;
+    break;
+  case ZERO_OR_MORE:
+    info->nullable = TRUE;
+    info->exact = FALSE;
+    info->prefixLen = 0;
+    break;
+  case ONE_OR_MORE:
+    // a match starts with a match of op1, which may repeat
+    info->exact = FALSE;
+    break;
+  case INTERSECT:
+    analyze_operand(expr->op2, expr->op2Type, &op2);
+
+    for (int c=0 ; c<ALPHABET_SIZE ; c++) {
+      info->firstBytes[c] &= op2.firstBytes[c];
+    }
+
+    // a match starts with the prefixes of both operands, the longer one
+    // is kept
+    if (op2.prefixLen > info->prefixLen) {
+      memcpy(info->prefix, op2.prefix, op2.prefixLen);
+      info->prefixLen = op2.prefixLen;
+    }
+
+    info->exact = FALSE;
+    info->nullable = info->nullable && op2.nullable;
+    break;
+  }
+}
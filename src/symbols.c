@@ -0,0 +1,265 @@
+#include <sched.h>
+#include "../include/symbols.h"
+#include "../include/hash.h"
+
+#define BUSY_SLOT  -1
+// an empty slot of slots being replaced, see SymbolTable
+#define MOVED_SLOT -2
+#define MIN_SLOTS  64
+
+static int find_or_add(SymbolTablePtr table, SymbolSlotsPtr slots,
+                       uint64_t hash, const char *name, int length);
+static void grow_slots(SymbolTablePtr table, SymbolSlotsPtr oldSlots);
+static SymbolSlotsPtr new_slots(long numSlots);
+static SymbolPtr get_symbol(SymbolTablePtr table, int id);
+static bool same_symbol(SymbolTablePtr table, int id, uint64_t hash,
+                        const char *name, int length);
+static int add_symbol(SymbolTablePtr table, uint64_t hash, const char *name,
+                      int length);
+
+void init_symbol_table(SymbolTablePtr table, int capacity) {
+  long numSlots = MIN_SLOTS;
+
+  while (numSlots < 2L * capacity) {
+    numSlots *= 2;
+  }
+
+  atomic_init(&table->slots, new_slots(numSlots));
+  pthread_mutex_init(&table->growLock, NULL);
+  pthread_mutex_init(&table->addLock, NULL);
+
+  for (int i=0 ; i<MAX_SYMBOL_CHUNKS ; i++) {
+    atomic_init(table->symbolChunks + i, NULL);
+  }
+
+  atomic_init(&table->numSymbols, 0);
+  table->nameChunks = NULL;
+  table->numNameChunks = 0;
+  table->nameChunksCapacity = 0;
+  table->nameEnd = NULL;
+  table->nameRoom = 0;
+}
+
+void free_symbol_table(SymbolTablePtr table) {
+  SymbolSlotsPtr slots = atomic_load(&table->slots);
+
+  while (slots != NULL) {
+    SymbolSlotsPtr prev = slots->prev;
+    free((void*)slots->slots);
+    free(slots);
+    slots = prev;
+  }
+
+  for (int i=0 ; i<MAX_SYMBOL_CHUNKS ; i++) {
+    free(atomic_load(table->symbolChunks + i));
+  }
+
+  for (int i=0 ; i<table->numNameChunks ; i++) {
+    free(table->nameChunks[i]);
+  }
+
+  free(table->nameChunks);
+  pthread_mutex_destroy(&table->growLock);
+  pthread_mutex_destroy(&table->addLock);
+}
+
+int intern_symbol(SymbolTablePtr table, const char *name, int length) {
+  uint64_t hash = hash_bytes(name, length, 0);
+
+  while (TRUE) {
+    SymbolSlotsPtr slots = atomic_load_explicit(&table->slots,
+                                                memory_order_acquire);
+    int id = find_or_add(table, slots, hash, name, length);
+
+    if (id != NO_SYMBOL) {
+      return id;
+    }
+
+    // the slots are being replaced, the new ones show up shortly
+    sched_yield();
+  }
+}
+
+void write_symbols(FILE *out, SymbolTablePtr table) {
+  int numSymbols = atomic_load(&table->numSymbols);
+
+  for (int id=0 ; id<numSymbols ; id++) {
+    SymbolPtr symbol = get_symbol(table, id);
+    fprintf(out, "%d %.*s\n", id, symbol->nameLength, symbol->name);
+  }
+}
+
+/// Looks a name up in the given slots, adding it if it's new. Returns
+/// NO_SYMBOL if the probe ran into a moved slot, the name has to be
+/// looked up in the slots replacing these ones then.
+static int find_or_add(SymbolTablePtr table, SymbolSlotsPtr slots,
+                       uint64_t hash, const char *name, int length) {
+  long mask = slots->numSlots - 1;
+
+  for (long slot=hash & mask ; ; slot=(slot+1) & mask) {
+    int entry = atomic_load_explicit(slots->slots + slot,
+                                     memory_order_acquire);
+
+    if (entry == 0) {
+      int expected = 0;
+
+      if (atomic_compare_exchange_strong(slots->slots + slot, &expected,
+                                         BUSY_SLOT)) {
+        int id = add_symbol(table, hash, name, length);
+        atomic_store_explicit(slots->slots + slot, id + 1,
+                              memory_order_release);
+
+        if (id + 1 > slots->numSlots / 2) {
+          grow_slots(table, slots);
+        }
+
+        return id;
+      }
+
+      // lost the race for the slot, look at what the winner put there
+      entry = expected;
+    }
+
+    while (entry == BUSY_SLOT) {
+      sched_yield();
+      entry = atomic_load_explicit(slots->slots + slot, memory_order_acquire);
+    }
+
+    if (entry == MOVED_SLOT) {
+      return NO_SYMBOL;
+    }
+
+    if (same_symbol(table, entry - 1, hash, name, length)) {
+      return entry - 1;
+    }
+  }
+}
+
+/// Replaces the given slots with twice as many, unless another thread
+/// did already. Every slot is either moved to the new slots, if it holds
+/// an id, or marked moved, if it's empty, which keeps other threads from
+/// adding to the old slots meanwhile. A busy slot is waited for, the
+/// thread that claimed it never needs the lock.
+static void grow_slots(SymbolTablePtr table, SymbolSlotsPtr oldSlots) {
+  pthread_mutex_lock(&table->growLock);
+
+  if (atomic_load(&table->slots) != oldSlots) {
+    pthread_mutex_unlock(&table->growLock);
+    return;
+  }
+
+  SymbolSlotsPtr slots = new_slots(2 * oldSlots->numSlots);
+  long mask = slots->numSlots - 1;
+
+  for (long s=0 ; s<oldSlots->numSlots ; s++) {
+    int entry;
+
+    while (TRUE) {
+      int expected = 0;
+
+      if (atomic_compare_exchange_strong(oldSlots->slots + s, &expected,
+                                         MOVED_SLOT)) {
+        entry = 0;
+        break;
+      }
+
+      if (expected != BUSY_SLOT) {
+        entry = expected;
+        break;
+      }
+
+      sched_yield();
+    }
+
+    if (entry == 0) {
+      continue;
+    }
+
+    long slot = get_symbol(table, entry - 1)->hash & mask;
+
+    while (atomic_load_explicit(slots->slots + slot,
+                                memory_order_relaxed) != 0) {
+      slot = (slot + 1) & mask;
+    }
+
+    atomic_store_explicit(slots->slots + slot, entry, memory_order_relaxed);
+  }
+
+  slots->prev = oldSlots;
+  atomic_store_explicit(&table->slots, slots, memory_order_release);
+  pthread_mutex_unlock(&table->growLock);
+}
+
+static SymbolSlotsPtr new_slots(long numSlots) {
+  SymbolSlotsPtr slots = malloc(sizeof(SymbolSlots));
+  assert(slots != NULL && "Out of memory!\n");
+  slots->slots = calloc(numSlots, sizeof(*slots->slots));
+  assert(slots->slots != NULL && "Out of memory!\n");
+  slots->numSlots = numSlots;
+  slots->prev = NULL;
+  return slots;
+}
+
+static SymbolPtr get_symbol(SymbolTablePtr table, int id) {
+  SymbolPtr chunk = atomic_load_explicit(table->symbolChunks
+                                         + id / SYMBOL_CHUNK_SIZE,
+                                         memory_order_relaxed);
+  return chunk + id % SYMBOL_CHUNK_SIZE;
+}
+
+static bool same_symbol(SymbolTablePtr table, int id, uint64_t hash,
+                        const char *name, int length) {
+  SymbolPtr symbol = get_symbol(table, id);
+  return symbol->hash == hash && symbol->nameLength == length
+    && memcmp(symbol->name, name, length) == 0;
+}
+
+/// Stores a new symbol and its name. The id is only published by the
+/// caller's release store of its slot, which also publishes the chunks.
+static int add_symbol(SymbolTablePtr table, uint64_t hash, const char *name,
+                      int length) {
+  pthread_mutex_lock(&table->addLock);
+  int id = atomic_load_explicit(&table->numSymbols, memory_order_relaxed);
+  int chunkIdx = id / SYMBOL_CHUNK_SIZE;
+
+  if (chunkIdx == MAX_SYMBOL_CHUNKS) {
+    fprintf(stderr, "Error: more than %ld distinct symbols to intern\n",
+            (long)SYMBOL_CHUNK_SIZE * MAX_SYMBOL_CHUNKS);
+    exit(1);
+  }
+
+  if (id % SYMBOL_CHUNK_SIZE == 0) {
+    SymbolPtr chunk = malloc(SYMBOL_CHUNK_SIZE*sizeof(Symbol));
+    assert(chunk != NULL && "Out of memory!\n");
+    atomic_store_explicit(table->symbolChunks + chunkIdx, chunk,
+                          memory_order_relaxed);
+  }
+
+  if (length > table->nameRoom) {
+    long chunkSize = length > NAME_CHUNK_SIZE ? length : NAME_CHUNK_SIZE;
+
+    if (table->numNameChunks == table->nameChunksCapacity) {
+      table->nameChunksCapacity = table->nameChunksCapacity == 0 ? 64
+        : 2 * table->nameChunksCapacity;
+      table->nameChunks = realloc(table->nameChunks,
+                                  table->nameChunksCapacity*sizeof(char*));
+      assert(table->nameChunks != NULL && "Out of memory!\n");
+    }
+
+    table->nameEnd = malloc(chunkSize);
+    assert(table->nameEnd != NULL && "Out of memory!\n");
+    table->nameChunks[table->numNameChunks++] = table->nameEnd;
+    table->nameRoom = chunkSize;
+  }
+
+  SymbolPtr symbol = get_symbol(table, id);
+  memcpy(table->nameEnd, name, length);
+  symbol->hash = hash;
+  symbol->name = table->nameEnd;
+  symbol->nameLength = length;
+  table->nameEnd += length;
+  table->nameRoom -= length;
+  atomic_store_explicit(&table->numSymbols, id + 1, memory_order_relaxed);
+  pthread_mutex_unlock(&table->addLock);
+  return id;
+}
@@ -0,0 +1,240 @@
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../include/tokfile.h"
+
+static void flush_block(TokenFileWriterPtr writer);
+static int write_varint(unsigned char *dest, uint64_t val);
+static bool read_varint(const unsigned char **src, const unsigned char *end,
+                        uint64_t *val);
+static bool read_encoded_token(const unsigned char **src,
+                               const unsigned char *end, long *prevEnd,
+                               TokenPtr token);
+
+void open_token_writer(TokenFileWriterPtr writer, FILE *out,
+                       uint64_t specHash) {
+  memset(&writer->header, 0, sizeof(TokenFileHeader));
+  writer->out = out;
+  writer->header.magic = TOKEN_FILE_MAGIC;
+  writer->header.version = TOKEN_FILE_VERSION;
+  writer->header.specHash = specHash;
+  writer->blockLen = 0;
+  writer->blockTokens = 0;
+  writer->prevEnd = 0;
+  writer->index = NULL;
+  writer->indexCapacity = 0;
+
+  // a placeholder, close_token_writer writes the actual header
+  fwrite(&writer->header, sizeof(TokenFileHeader), 1, out);
+}
+
+void write_tokens_binary(TokenFileWriterPtr writer, TokenBufferPtr tokens) {
+  for (long i=0 ; i<tokens->size ; i++) {
+    TokenPtr token = tokens->tokens + i;
+
+    if (writer->blockTokens == 0) {
+      if (writer->header.numBlocks == writer->indexCapacity) {
+        writer->indexCapacity = writer->indexCapacity == 0 ? 64
+          : 2 * writer->indexCapacity;
+        writer->index = realloc(writer->index,
+                                writer->indexCapacity*sizeof(TokenBlockEntry));
+        assert(writer->index != NULL && "Out of memory!\n");
+      }
+
+      TokenBlockEntryPtr entry = writer->index + writer->header.numBlocks++;
+      entry->fileOffset = ftell(writer->out);
+      entry->prevEnd = writer->prevEnd;
+    }
+
+    assert(token->offset >= writer->prevEnd && "Tokens out of order!\n");
+    unsigned char *dest = writer->block + writer->blockLen;
+    dest += write_varint(dest, (uint64_t)(token->kind + 1));
+    dest += write_varint(dest, (uint64_t)(token->offset - writer->prevEnd));
+    dest += write_varint(dest, (uint64_t)token->length);
+    writer->blockLen = dest - writer->block;
+    writer->prevEnd = token->offset + token->length;
+    writer->header.numTokens++;
+
+    if (++writer->blockTokens == TOKEN_FILE_BLOCK_SIZE) {
+      flush_block(writer);
+    }
+  }
+}
+
+void close_token_writer(TokenFileWriterPtr writer) {
+  flush_block(writer);
+  writer->header.indexOffset = ftell(writer->out);
+  fwrite(writer->index, sizeof(TokenBlockEntry), writer->header.numBlocks,
+         writer->out);
+  fseek(writer->out, 0, SEEK_SET);
+  fwrite(&writer->header, sizeof(TokenFileHeader), 1, writer->out);
+  fseek(writer->out, 0, SEEK_END);
+  free(writer->index);
+  writer->index = NULL;
+}
+
+bool open_token_file(const char *path, TokenFilePtr file) {
+  int fd = open(path, O_RDONLY);
+  struct stat st;
+
+  if (fd < 0 || fstat(fd, &st) != 0
+      || (size_t)st.st_size < sizeof(TokenFileHeader)) {
+    fprintf(stderr, "Error: cannot read token file %s\n", path);
+
+    if (fd >= 0) {
+      close(fd);
+    }
+
+    return FALSE;
+  }
+
+  file->size = st.st_size;
+  file->data = mmap(NULL, file->size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+
+  if (file->data == MAP_FAILED) {
+    fprintf(stderr, "Error: cannot map token file %s\n", path);
+    return FALSE;
+  }
+
+  file->header = (const TokenFileHeader*)file->data;
+  const TokenFileHeader *header = file->header;
+  // the sizes are checked by division, a huge numBlocks mustn't wrap
+  bool valid = header->magic == TOKEN_FILE_MAGIC
+    && header->version == TOKEN_FILE_VERSION
+    && header->indexOffset >= sizeof(TokenFileHeader)
+    && header->indexOffset <= file->size
+    && header->numBlocks <= (file->size - header->indexOffset)
+                            / sizeof(TokenBlockEntry)
+    && header->numTokens <= header->numBlocks * TOKEN_FILE_BLOCK_SIZE
+    // only the last block may be partial, but not empty
+    && (header->numBlocks == 0 || header->numTokens
+        > (header->numBlocks - 1) * TOKEN_FILE_BLOCK_SIZE);
+
+  if (valid) {
+    file->index = (const TokenBlockEntry*)(file->data + header->indexOffset);
+  }
+
+  for (uint64_t i=0 ; valid && i<header->numBlocks ; i++) {
+    valid = file->index[i].fileOffset >= sizeof(TokenFileHeader)
+      && file->index[i].fileOffset < header->indexOffset;
+  }
+
+  if (!valid) {
+    fprintf(stderr, "Error: %s is not a valid token file\n", path);
+    close_token_file(file);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+void close_token_file(TokenFilePtr file) {
+  munmap((void*)file->data, file->size);
+  file->data = NULL;
+}
+
+int read_token_block(TokenFilePtr file, uint64_t blockIdx, TokenPtr tokens) {
+  assert(blockIdx < file->header->numBlocks && "Invalid block!\n");
+  const unsigned char *src = file->data + file->index[blockIdx].fileOffset;
+  const unsigned char *end = file->data + file->header->indexOffset;
+  long prevEnd = (long)file->index[blockIdx].prevEnd;
+  int numTokens = TOKEN_FILE_BLOCK_SIZE;
+
+  // only the last block may be partial
+  if (blockIdx == file->header->numBlocks - 1) {
+    numTokens = file->header->numTokens
+      - blockIdx * TOKEN_FILE_BLOCK_SIZE;
+  }
+
+  for (int i=0 ; i<numTokens ; i++) {
+    if (!read_encoded_token(&src, end, &prevEnd, tokens + i)) {
+      return -1;
+    }
+  }
+
+  return numTokens;
+}
+
+bool read_token(TokenFilePtr file, uint64_t tokenIdx, TokenPtr token) {
+  assert(tokenIdx < file->header->numTokens && "Invalid token!\n");
+  uint64_t blockIdx = tokenIdx / TOKEN_FILE_BLOCK_SIZE;
+  const unsigned char *src = file->data + file->index[blockIdx].fileOffset;
+  const unsigned char *end = file->data + file->header->indexOffset;
+  long prevEnd = (long)file->index[blockIdx].prevEnd;
+
+  for (uint64_t i=0 ; i<=tokenIdx % TOKEN_FILE_BLOCK_SIZE ; i++) {
+    if (!read_encoded_token(&src, end, &prevEnd, token)) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+static void flush_block(TokenFileWriterPtr writer) {
+  fwrite(writer->block, 1, writer->blockLen, writer->out);
+  writer->blockLen = 0;
+  writer->blockTokens = 0;
+}
+
+/// LEB128: 7 bits per byte, least significant first, the high bit set on
+/// all but the last byte. Returns the number of bytes written.
+static int write_varint(unsigned char *dest, uint64_t val) {
+  int len = 0;
+
+  while (val >= 0x80) {
+    dest[len++] = (unsigned char)(val | 0x80);
+    val >>= 7;
+  }
+
+  dest[len++] = (unsigned char)val;
+  return len;
+}
+
+/// Reads a varint ending before end. Returns FALSE if it doesn't, or if
+/// it's longer than the 10 bytes of a 64-bit value.
+static bool read_varint(const unsigned char **src, const unsigned char *end,
+                        uint64_t *val) {
+  const unsigned char *p = *src;
+  int shift = 0;
+  *val = 0;
+
+  while (p < end && (*p & 0x80) && shift < 63) {
+    *val |= (uint64_t)(*p++ & 0x7f) << shift;
+    shift += 7;
+  }
+
+  if (p == end || (*p & 0x80)) {
+    return FALSE;
+  }
+
+  *val |= (uint64_t)(*p++) << shift;
+  *src = p;
+  return TRUE;
+}
+
+/// Decodes the 3 varints of a token, see tokfile.h. Only the kind's range
+/// is left for the caller to check, it's the spec's business.
+static bool read_encoded_token(const unsigned char **src,
+                               const unsigned char *end, long *prevEnd,
+                               TokenPtr token) {
+  uint64_t kind;
+  uint64_t gap;
+  uint64_t length;
+
+  if (!read_varint(src, end, &kind) || !read_varint(src, end, &gap)
+      || !read_varint(src, end, &length) || kind > INT_MAX
+      || gap > (uint64_t)(LONG_MAX - *prevEnd) || length > INT_MAX
+      || length > (uint64_t)(LONG_MAX - *prevEnd - (long)gap)) {
+    return FALSE;
+  }
+
+  token->kind = (int)kind - 1;
+  token->offset = *prevEnd + (long)gap;
+  token->length = (int)length;
+  *prevEnd = token->offset + token->length;
+  return TRUE;
+}
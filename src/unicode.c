@@ -0,0 +1,191 @@
+#include "../include/unicode.h"
+
+#define FIRST_SURROGATE 0xD800
+#define LAST_SURROGATE  0xDFFF
+
+static int encode_utf8(uint32_t codePoint, unsigned char *bytes);
+static int compare_ranges(const void *a, const void *b);
+
+int get_category_ranges(const char *name, int nameSize,
+                        CodePointRangePtr ranges, int maxRanges) {
+  if (nameSize < 1 || nameSize > 2) {
+    return -1;
+  }
+
+  int numRanges = 0;
+
+  for (int i=0 ; i<categoryTableSize ; i++) {
+    const CategoryRange *range = categoryTable + i;
+
+    if (memcmp(range->category, name, nameSize) != 0) {
+      continue;
+    }
+
+    if (numRanges == maxRanges) {
+      return TOO_MANY_RANGES;
+    }
+
+    ranges[numRanges].first = range->first;
+    ranges[numRanges].last = range->last;
+    numRanges++;
+  }
+
+  return numRanges == 0 ? -1 : numRanges;
+}
+
+int normalize_code_point_ranges(CodePointRangePtr ranges, int numRanges,
+                                int maxRanges) {
+  if (numRanges == 0) {
+    return 0;
+  }
+
+  qsort(ranges, numRanges, sizeof(CodePointRange), compare_ranges);
+  int numMerged = 1;
+
+  for (int i=1 ; i<numRanges ; i++) {
+    CodePointRangePtr last = ranges + numMerged - 1;
+
+    if (ranges[i].first <= last->last + 1) {
+      last->last = ranges[i].last > last->last ? ranges[i].last : last->last;
+    } else {
+      ranges[numMerged++] = ranges[i];
+    }
+  }
+
+  // the ranges are sorted and disjoint, hence, at most 2 pieces of the
+  // ones overlapping the surrogates survive. Code point 0 is cut out as
+  // well, its byte marks epsilon edges (see EPSILON).
+  int numRanges2 = 0;
+  CodePointRange split[2];
+  int numSplit = 0;
+  int i = 0;
+
+  if (ranges[0].first == 0) {
+    ranges[0].first = 1;
+    i = ranges[0].last == 0 ? 1 : 0;
+  }
+
+  for ( ; i<numMerged ; i++) {
+    CodePointRange range = ranges[i];
+
+    if (range.last < FIRST_SURROGATE || range.first > LAST_SURROGATE) {
+      ranges[numRanges2++] = range;
+      continue;
+    }
+
+    if (range.first < FIRST_SURROGATE) {
+      split[numSplit].first = range.first;
+      split[numSplit++].last = FIRST_SURROGATE - 1;
+    }
+
+    if (range.last > LAST_SURROGATE) {
+      split[numSplit].first = LAST_SURROGATE + 1;
+      split[numSplit++].last = range.last;
+    }
+  }
+
+  if (numRanges2 + numSplit > maxRanges) {
+    return TOO_MANY_RANGES;
+  }
+
+  for (int i=0 ; i<numSplit ; i++) {
+    ranges[numRanges2++] = split[i];
+  }
+
+  qsort(ranges, numRanges2, sizeof(CodePointRange), compare_ranges);
+  return numRanges2;
+}
+
+int split_utf8_sequences(CodePointRange range, Utf8SequencePtr sequences) {
+  // the last code point of every encoded length
+  static const uint32_t lengthEnds[MAX_UTF8_LEN-1] = {0x7F, 0x7FF, 0xFFFF};
+  CodePointRange stack[MAX_SEQUENCES_PER_RANGE * 2];
+  int stackSize = 0;
+  int numSequences = 0;
+  stack[stackSize++] = range;
+
+  // the higher half of a split is pushed first, which keeps the
+  // sequences in increasing order
+  while (stackSize > 0) {
+    CodePointRange r = stack[--stackSize];
+    bool split = FALSE;
+
+    for (int i=0 ; i<MAX_UTF8_LEN-1 && !split ; i++) {
+      if (r.first <= lengthEnds[i] && lengthEnds[i] < r.last) {
+        stack[stackSize].first = lengthEnds[i] + 1;
+        stack[stackSize++].last = r.last;
+        stack[stackSize].first = r.first;
+        stack[stackSize++].last = lengthEnds[i];
+        split = TRUE;
+      }
+    }
+
+    // within an encoded length, split until the range covers all the
+    // values of the continuation bytes it differs in
+    for (int i=1 ; i<MAX_UTF8_LEN && !split ; i++) {
+      uint32_t mask = (1u << (6*i)) - 1;
+
+      if ((r.first & ~mask) == (r.last & ~mask)) {
+        continue;
+      }
+
+      if ((r.first & mask) != 0) {
+        stack[stackSize].first = (r.first | mask) + 1;
+        stack[stackSize++].last = r.last;
+        stack[stackSize].first = r.first;
+        stack[stackSize++].last = r.first | mask;
+        split = TRUE;
+      } else if ((r.last & mask) != mask) {
+        stack[stackSize].first = r.last & ~mask;
+        stack[stackSize++].last = r.last;
+        stack[stackSize].first = r.first;
+        stack[stackSize++].last = (r.last & ~mask) - 1;
+        split = TRUE;
+      }
+    }
+
+    if (split) {
+      continue;
+    }
+
+    assert(numSequences < MAX_SEQUENCES_PER_RANGE && "Too many UTF-8"
+           " sequences!\n");
+    Utf8SequencePtr sequence = sequences + numSequences++;
+    sequence->length = encode_utf8(r.first, sequence->first);
+    encode_utf8(r.last, sequence->last);
+  }
+
+  return numSequences;
+}
+
+static int encode_utf8(uint32_t codePoint, unsigned char *bytes) {
+  if (codePoint <= 0x7F) {
+    bytes[0] = codePoint;
+    return 1;
+  }
+
+  if (codePoint <= 0x7FF) {
+    bytes[0] = 0xC0 | (codePoint >> 6);
+    bytes[1] = 0x80 | (codePoint & 0x3F);
+    return 2;
+  }
+
+  if (codePoint <= 0xFFFF) {
+    bytes[0] = 0xE0 | (codePoint >> 12);
+    bytes[1] = 0x80 | ((codePoint >> 6) & 0x3F);
+    bytes[2] = 0x80 | (codePoint & 0x3F);
+    return 3;
+  }
+
+  bytes[0] = 0xF0 | (codePoint >> 18);
+  bytes[1] = 0x80 | ((codePoint >> 12) & 0x3F);
+  bytes[2] = 0x80 | ((codePoint >> 6) & 0x3F);
+  bytes[3] = 0x80 | (codePoint & 0x3F);
+  return 4;
+}
+
+static int compare_ranges(const void *a, const void *b) {
+  uint32_t x = ((const CodePointRange *)a)->first;
+  uint32_t y = ((const CodePointRange *)b)->first;
+  return (x > y) - (x < y);
+}
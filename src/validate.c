@@ -0,0 +1,110 @@
+#include "../include/validate.h"
+
+#define step(state, c)                                          \
+  ((state) = table[(state) * ALPHABET_SIZE + (unsigned char)(c)])
+
+static PoolOffset finish_string(PoolOffset *table, PoolOffset state,
+                                const char *str, int len);
+
+void init_validator(ValidatorPtr validator, int nontermIdx,
+                    NFAStatePtr nfaStateTable, NFAEdgePtr nfaEdgeTable,
+                    NFAPtr nfaTable) {
+  DFAStatePtr dfaStateTable = NULL;
+  DFAPtr dfaTable = NULL;
+  PoolOffset dfaIdx = build_dfa(nfaStateTable, nfaEdgeTable, nfaTable,
+                                get_non_terminal_nfa(nontermIdx),
+                                &dfaStateTable, &dfaTable);
+  DFAPtr dfa = dfaTable + dfaIdx;
+
+  // state s of the DFA becomes state s - start + 1, DEAD_STATE becomes 0
+  validator->numStates = dfa->numStates + 1;
+  validator->start = 1;
+  validator->table = calloc(validator->numStates * ALPHABET_SIZE,
+                            sizeof(PoolOffset));
+  validator->accepting = calloc(validator->numStates, sizeof(bool));
+  assert(validator->table != NULL && validator->accepting != NULL
+         && "Out of memory!\n");
+
+  for (int s=0 ; s<dfa->numStates ; s++) {
+    DFAStatePtr state = dfaStateTable + dfa->start + s;
+    PoolOffset *row = validator->table + (s+1) * ALPHABET_SIZE;
+    validator->accepting[s+1] = state->token != NO_TOKEN;
+
+    for (int c=0 ; c<ALPHABET_SIZE ; c++) {
+      PoolOffset target = state->transitions[c];
+      row[c] = target == DEAD_STATE ? 0 : target - dfa->start + 1;
+    }
+  }
+}
+
+void free_validator(ValidatorPtr validator) {
+  free(validator->table);
+  free(validator->accepting);
+  validator->table = NULL;
+  validator->accepting = NULL;
+}
+
+bool validate_string(ValidatorPtr validator, const char *str, int len) {
+  PoolOffset state = finish_string(validator->table, validator->start, str,
+                                   len);
+  return validator->accepting[state];
+}
+
+/// Runs the rest of a string through the DFA starting at state, stopping
+/// early once it's dead
+static PoolOffset finish_string(PoolOffset *table, PoolOffset state,
+                                const char *str, int len) {
+  for (int i=0 ; i<len && state != 0 ; i++) {
+    step(state, str[i]);
+  }
+
+  return state;
+}
+
+void validate_strings(ValidatorPtr validator, const char *const *strs,
+                      const int *lens, long numStrs, uint64_t *matches) {
+  PoolOffset *table = validator->table;
+  long i = 0;
+
+  memset(matches, 0, ((numStrs + 63) / 64) * sizeof(uint64_t));
+
+  for ( ; i+VALIDATE_INTERLEAVE<=numStrs ; i+=VALIDATE_INTERLEAVE) {
+    const char *s0 = strs[i], *s1 = strs[i+1], *s2 = strs[i+2],
+      *s3 = strs[i+3];
+    int l0 = lens[i], l1 = lens[i+1], l2 = lens[i+2], l3 = lens[i+3];
+    PoolOffset st0 = validator->start, st1 = st0, st2 = st0, st3 = st0;
+    int common = l0;
+
+    common = l1 < common ? l1 : common;
+    common = l2 < common ? l2 : common;
+    common = l3 < common ? l3 : common;
+
+    // the dead state loops to itself, hence, no string needs to stop
+    // before the shortest one ends
+    int k = 0;
+
+    for ( ; k<common ; k++) {
+      step(st0, s0[k]);
+      step(st1, s1[k]);
+      step(st2, s2[k]);
+      step(st3, s3[k]);
+    }
+
+    st0 = finish_string(table, st0, s0 + k, l0 - k);
+    st1 = finish_string(table, st1, s1 + k, l1 - k);
+    st2 = finish_string(table, st2, s2 + k, l2 - k);
+    st3 = finish_string(table, st3, s3 + k, l3 - k);
+
+    uint64_t bits = (uint64_t)validator->accepting[st0]
+      | (uint64_t)validator->accepting[st1] << 1
+      | (uint64_t)validator->accepting[st2] << 2
+      | (uint64_t)validator->accepting[st3] << 3;
+    matches[i / 64] |= bits << (i % 64);
+  }
+
+  for ( ; i<numStrs ; i++) {
+    if (validate_string(validator, strs[i], lens[i])) {
+      matches[i / 64] |= (uint64_t)1 << (i % 64);
+    }
+  }
+}
@@ -0,0 +1,32 @@
+# Checks that --search reports the same spans as a normal scan for a rule
+# with a trailing context (r @/ s). Run by ctest with BIN set to the
+# compiler and DIR to a scratch directory.
+
+file(MAKE_DIRECTORY ${DIR})
+file(WRITE ${DIR}/trailing.spec "$num := 0 | 1 @/ ..\n")
+file(WRITE ${DIR}/trailing.txt "x 1.. 0..y")
+file(WRITE ${DIR}/trailing.list "${DIR}/trailing.txt\n")
+
+execute_process(COMMAND ${BIN} --spec ${DIR}/trailing.spec
+                --batch ${DIR}/trailing.list
+                RESULT_VARIABLE result OUTPUT_QUIET ERROR_QUIET)
+
+if (NOT result EQUAL 0)
+  message(FATAL_ERROR "scanning failed: ${result}")
+endif ()
+
+file(STRINGS ${DIR}/trailing.txt.tokens scanned REGEX "\\$num$")
+
+execute_process(COMMAND ${BIN} --spec ${DIR}/trailing.spec
+                --batch ${DIR}/trailing.list --search num
+                RESULT_VARIABLE result OUTPUT_QUIET ERROR_QUIET)
+
+if (NOT result EQUAL 0)
+  message(FATAL_ERROR "searching failed: ${result}")
+endif ()
+
+file(STRINGS ${DIR}/trailing.txt.tokens searched)
+
+if (NOT scanned STREQUAL searched OR NOT searched STREQUAL "2 1 $num;6 1 $num")
+  message(FATAL_ERROR "scan found '${scanned}', search found '${searched}'")
+endif ()